@@ -76,19 +76,44 @@
 
 /* Memory allocation related definitions. */
 #define configSUPPORT_STATIC_ALLOCATION         1
+/* Define STATIC_ALLOCATION_ONLY to create all RTOS objects statically and to
+ * build without the FreeRTOS heap. The idle and timer daemon task memory is
+ * provided by the RTOS abstraction library through
+ * vApplicationGetIdleTaskMemory and vApplicationGetTimerTaskMemory.
+ */
+#if defined(STATIC_ALLOCATION_ONLY)
+#define configSUPPORT_DYNAMIC_ALLOCATION        0
+#define configTOTAL_HEAP_SIZE                   0
+#else
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
 #define configTOTAL_HEAP_SIZE                   10240
+#endif
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                     0
 #define configUSE_TICK_HOOK                     0
 #define configCHECK_FOR_STACK_OVERFLOW          2
+#if defined(STATIC_ALLOCATION_ONLY)
+#define configUSE_MALLOC_FAILED_HOOK            0
+#else
 #define configUSE_MALLOC_FAILED_HOOK            1
+#endif
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
-/* Run time and task stats gathering related definitions. */
+/* Run time and task stats gathering related definitions. With
+ * RUNTIME_STATS_ENABLE, the run time is counted with the LPTimer, which keeps
+ * running in tickless deep sleep (see source/runtime_stats.c).
+ */
+#if defined(RUNTIME_STATS_ENABLE)
+#define configGENERATE_RUN_TIME_STATS           1
+extern void runtime_stats_init(void);
+extern uint32_t runtime_stats_get_counter(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    runtime_stats_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()            runtime_stats_get_counter()
+#else
 #define configGENERATE_RUN_TIME_STATS           0
+#endif
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
@@ -158,8 +183,12 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#if defined(RUNTIME_STATS_ENABLE)
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#else
 #define INCLUDE_xTaskGetIdleTaskHandle          0
+#endif
 #define INCLUDE_eTaskGetState                   0
 #define INCLUDE_xEventGroupSetBitFromISR        1
 #define INCLUDE_xTimerPendFunctionCall          1
@@ -189,7 +218,11 @@ standard names - or at least those used in the unmodified vector table. */
 #define HEAP_ALLOCATION_TYPE5                   (5)     /* heap_5.c*/
 #define NO_HEAP_ALLOCATION                      (0)
 
+#if defined(STATIC_ALLOCATION_ONLY)
+#define configHEAP_ALLOCATION_SCHEME            (NO_HEAP_ALLOCATION)
+#else
 #define configHEAP_ALLOCATION_SCHEME            (HEAP_ALLOCATION_TYPE3)
+#endif
 
 /* Check if the ModusToolbox Device Configurator Power personality parameter
  * "System Idle Power Mode" is set to either "CPU Sleep" or "System Deep Sleep".
@@ -206,7 +239,15 @@ standard names - or at least those used in the unmodified vector table. */
  * https://github.com/cypresssemiconductorco/lpa
  */
 extern void vApplicationSleep( uint32_t xExpectedIdleTime );
+#if defined(UART_TX_DMA_ENABLE)
+/* Enters CPU sleep explicitly while the DMA UART path has data to send, which
+ * refuses deep sleep, and calls vApplicationSleep otherwise (source/uart_tx.c).
+ */
+extern void uart_tx_idle_sleep( uint32_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xIdleTime ) uart_tx_idle_sleep( xIdleTime )
+#else
 #define portSUPPRESS_TICKS_AND_SLEEP( xIdleTime ) vApplicationSleep( xIdleTime )
+#endif
 #define configUSE_TICKLESS_IDLE                 2
 
 #else
@@ -0,0 +1,335 @@
+/******************************************************************************
+* File Name:   host_sim.c
+*
+* Description: Host simulation of capsense_task. Runs the FSM of capsense.c with the
+*              scan policy, scan plan, energy model, touch predictor and gesture
+*              recognizer against stand-ins of the CapSense middleware, the HAL and
+*              FreeRTOS, driven by a scripted touch trace, and reports the scan rate,
+*              the modeled average current, the time per FSM state and the deep
+*              sleep residency.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "capsense.h"
+#include "residency.h"
+#include "scan_stats.h"
+#if (defined(TUNER_SNAPSHOT_ENABLE))
+#include "tuner_snapshot.h"
+#endif /* TUNER_SNAPSHOT_ENABLE */
+#if (defined(UART_TX_DMA_ENABLE))
+#include "uart_tx.h"
+#endif /* UART_TX_DMA_ENABLE */
+#if (defined(RUNTIME_STATS_ENABLE))
+#include "runtime_stats.h"
+#endif /* RUNTIME_STATS_ENABLE */
+#include "touch_event.h"
+
+#include "sim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define NUM_EVENT_TYPES                 (16U)
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+/* FSM states of capsense_task, indexed by the state values of capsense.c. */
+static const char *const state_names[] =
+{
+    [1] = "INITIATE_SCAN",
+    [2] = "WAIT_IN_SLEEP",
+    [3] = "PROCESS_TOUCH",
+    [4] = "WAIT_IN_DEEP_SLEEP"
+};
+
+static const char *const event_names[NUM_EVENT_TYPES] =
+{
+    [TOUCH_EVENT_SLIDER_POSITION]   = "slider position",
+    [TOUCH_EVENT_SCAN_RATE]         = "scan rate",
+    [TOUCH_EVENT_GESTURE]           = "gesture",
+    [TOUCH_EVENT_AVERAGE_CURRENT]   = "average current",
+    [TOUCH_EVENT_TRIGGER_LATENCY]   = "trigger latency",
+    [TOUCH_EVENT_TOUCH_STATE]       = "touch state",
+    [TOUCH_EVENT_SENSOR_COUNTS]     = "sensor counts",
+    [TOUCH_EVENT_DROPPED]           = "dropped",
+    [TOUCH_EVENT_STACK_HIGH_WATER]  = "stack high water",
+    [TOUCH_EVENT_RUN_TIME]          = "run time"
+};
+
+static uint32_t event_counts[NUM_EVENT_TYPES];
+
+#if (defined(RUNTIME_STATS_ENABLE))
+/* Tasks of TOUCH_EVENT_RUN_TIME, indexed by runtime_stats_task_t. */
+static const char *const task_names[RUNTIME_STATS_NUM_TASKS] =
+{
+    [RUNTIME_STATS_CAPSENSE_TASK]       = "CapSense Task",
+    [RUNTIME_STATS_TOUCH_EVENT_TASK]    = "Touch Event Task",
+    [RUNTIME_STATS_TIMER_TASK]          = "Timer Task",
+    [RUNTIME_STATS_IDLE_TASK]           = "Idle Task"
+};
+
+/* CPU time of every task in the last report, in us and in 0.1 % of the
+ * report interval. The share is UINT32_MAX if the task is not reported.
+ */
+static uint32_t task_run_time_us[RUNTIME_STATS_NUM_TASKS];
+static uint32_t task_run_time_share[RUNTIME_STATS_NUM_TASKS] =
+{
+    UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX
+};
+#endif /* RUNTIME_STATS_ENABLE */
+
+/* touch_event_task is not simulated. */
+TaskHandle_t touch_event_task_handle;
+static bool is_verbose;
+static jmp_buf end_jump;
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void print_report(const char *trace_path);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Runs capsense_task over the trace given on the command line.
+*
+*   host_sim [-v] <trace>
+*
+* -v prints the touch events posted by capsense_task.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    const char *trace_path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "-v"))
+        {
+            is_verbose = true;
+        }
+        else if (NULL == trace_path)
+        {
+            trace_path = argv[i];
+        }
+        else
+        {
+            trace_path = NULL;
+            break;
+        }
+    }
+
+    if (NULL == trace_path)
+    {
+        fprintf(stderr, "usage: %s [-v] <trace>\n", argv[0]);
+        return 2;
+    }
+
+    if (!sim_trace_load(trace_path))
+    {
+        return 1;
+    }
+
+    sim_init(sim_trace_get_end_time_us(), &end_jump);
+    capsense_task_handle = sim_rtos_get_task_handle();
+
+#if (defined(RUNTIME_STATS_ENABLE))
+    /* Called by vTaskStartScheduler on the target. */
+    runtime_stats_init();
+#endif /* RUNTIME_STATS_ENABLE */
+
+    /* capsense_task never returns; the simulation jumps back here at the end
+     * of the trace.
+     */
+    if (0 == setjmp(end_jump))
+    {
+        capsense_task(NULL);
+    }
+
+    print_report(trace_path);
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: touch_event_post
+********************************************************************************
+* Summary: Stand-in for the event queue of touch_event.c. The events are
+* counted, and printed with -v.
+*
+*******************************************************************************/
+bool touch_event_post(touch_event_type_t type, uint8_t arg, uint16_t value, int32_t data)
+{
+    uint64_t now_us = sim_get_time_us();
+
+    if (NUM_EVENT_TYPES > (uint32_t)type)
+    {
+        event_counts[type]++;
+    }
+
+#if (defined(RUNTIME_STATS_ENABLE))
+    if ((TOUCH_EVENT_RUN_TIME == type) && (RUNTIME_STATS_NUM_TASKS > arg))
+    {
+        task_run_time_us[arg] = (uint32_t)data;
+        task_run_time_share[arg] = value;
+    }
+#endif /* RUNTIME_STATS_ENABLE */
+
+    if (is_verbose)
+    {
+        printf("%6lu.%03lu s  %-16s arg %3u value %5u data %ld\n",
+               (unsigned long)(now_us / 1000000U), (unsigned long)((now_us / 1000U) % 1000U),
+               ((NUM_EVENT_TYPES > (uint32_t)type) && (NULL != event_names[type])) ?
+               event_names[type] : "?", arg, value, (long)data);
+    }
+
+    return true;
+}
+
+
+#if (defined(UART_TX_DMA_ENABLE))
+/*******************************************************************************
+* Function Name: uart_tx_flush
+********************************************************************************
+* Summary: Stand-in for the DMA transmit path of uart_tx.c. The output of the
+* simulation is written to stdout directly, so no data is ever buffered.
+*
+*******************************************************************************/
+void uart_tx_flush(void)
+{
+}
+#endif /* UART_TX_DMA_ENABLE */
+
+
+/*******************************************************************************
+* Function Name: print_report
+*******************************************************************************/
+static void print_report(const char *trace_path)
+{
+    uint64_t time_us = sim_get_time_us();
+    uint64_t time_ms = time_us / 1000U;
+    uint32_t num_scans = 0U;
+    uint32_t average_current_na = sim_capsense_get_average_current_na();
+
+    for (uint32_t widget_id = 0; widget_id < CY_CAPSENSE_WIDGET_COUNT; widget_id++)
+    {
+        num_scans += sim_capsense_get_scan_count(widget_id);
+    }
+
+    printf("Trace %s, %lu.%03lu s\n", trace_path,
+           (unsigned long)(time_ms / 1000U), (unsigned long)(time_ms % 1000U));
+
+    if (0U == time_ms)
+    {
+        return;
+    }
+
+    printf("Scans: %lu (%lu.%02lu /s), LinearSlider0 %lu, GangedSensor %lu\n",
+           (unsigned long)num_scans,
+           (unsigned long)((num_scans * 1000ULL) / time_ms),
+           (unsigned long)(((num_scans * 100000ULL) / time_ms) % 100U),
+           (unsigned long)sim_capsense_get_scan_count(CY_CAPSENSE_LINEARSLIDER0_WDGT_ID),
+           (unsigned long)sim_capsense_get_scan_count(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID));
+    printf("Full processing: LinearSlider0 %lu, GangedSensor %lu\n",
+           (unsigned long)sim_capsense_get_process_count(CY_CAPSENSE_LINEARSLIDER0_WDGT_ID),
+           (unsigned long)sim_capsense_get_process_count(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID));
+    printf("Wake-ups: %lu (%lu.%02lu /s)\n",
+           (unsigned long)sim_get_wakeup_count(),
+           (unsigned long)((sim_get_wakeup_count() * 1000ULL) / time_ms),
+           (unsigned long)(((sim_get_wakeup_count() * 100000ULL) / time_ms) % 100U));
+
+    printf("Task wake-ups: %lu (%lu.%02lu /s)\n",
+           (unsigned long)sim_rtos_get_task_wakeup_count(),
+           (unsigned long)((sim_rtos_get_task_wakeup_count() * 1000ULL) / time_ms),
+           (unsigned long)(((sim_rtos_get_task_wakeup_count() * 100000ULL) / time_ms) % 100U));
+
+    printf("Average current (energy model): %lu.%03lu uA\n",
+           (unsigned long)(average_current_na / 1000U), (unsigned long)(average_current_na % 1000U));
+#if (defined(TUNER_SNAPSHOT_ENABLE))
+    /* No host drains the ring, so all snapshots after the first
+     * TUNER_SNAPSHOT_RING_SIZE are dropped.
+     */
+    printf("Tuner snapshots dropped: %lu\n", (unsigned long)tuner_snapshot_get_dropped_count());
+#endif /* TUNER_SNAPSHOT_ENABLE */
+#if (defined(RUNTIME_STATS_ENABLE))
+    printf("Run time (last report):");
+    for (uint32_t i = 0; i < RUNTIME_STATS_NUM_TASKS; i++)
+    {
+        if (UINT32_MAX != task_run_time_share[i])
+        {
+            printf(" %s %lu us (%lu.%lu %%),", task_names[i], (unsigned long)task_run_time_us[i],
+                   (unsigned long)(task_run_time_share[i] / 10U),
+                   (unsigned long)(task_run_time_share[i] % 10U));
+        }
+    }
+    printf("\n");
+#endif /* RUNTIME_STATS_ENABLE */
+    printf("Events:");
+    for (uint32_t type = 0; type < NUM_EVENT_TYPES; type++)
+    {
+        if (0U != event_counts[type])
+        {
+            printf(" %s %lu,", event_names[type], (unsigned long)event_counts[type]);
+        }
+    }
+    printf("\n");
+
+    residency_print(state_names, sizeof(state_names) / sizeof(state_names[0]));
+
+#if (defined(SCAN_LATENCY_STATS_ENABLE))
+    scan_stats_print();
+#endif /* SCAN_LATENCY_STATS_ENABLE */
+}
+
+
+/* [] END OF FILE */
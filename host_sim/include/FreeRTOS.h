@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name:   FreeRTOS.h
+*
+* Description: Host stand-in for the FreeRTOS kernel configuration and types. The
+*              simulated kernel runs capsense_task as its only task.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_SIM_FREERTOS_H
+#define HOST_SIM_FREERTOS_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Same tick rate as FreeRTOSConfig.h. */
+#define configTICK_RATE_HZ              (1000u)
+#define configMINIMAL_STACK_SIZE        (128)
+#define configMAX_PRIORITIES            (7)
+#define configTIMER_TASK_PRIORITY       (2)
+
+#define portTICK_PERIOD_MS              ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY                   ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(xTimeInMs)        ((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+
+#define pdFALSE                         ((BaseType_t)0)
+#define pdTRUE                          ((BaseType_t)1)
+#define pdPASS                          (pdTRUE)
+#define pdFAIL                          (pdFALSE)
+
+#define configASSERT(x)                 do { if (!(x)) { abort(); } } while (0)
+#define portYIELD_FROM_ISR(x)           ((void)(x))
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+typedef struct
+{
+    uint32_t reserved;
+} StaticTask_t;
+
+typedef struct
+{
+    uint32_t reserved;
+} StaticTimer_t;
+
+
+#endif /* HOST_SIM_FREERTOS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,179 @@
+/******************************************************************************
+* File Name:   cy_pdl.h
+*
+* Description: Host stand-in for the parts of the PDL used by the application
+*              sources that are compiled into the host simulation.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_SIM_CY_PDL_H
+#define HOST_SIM_CY_PDL_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/* As on the target, where the PDL includes the CMSIS core header. */
+#include "cmsis_compiler.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CY_RSLT_SUCCESS                 (0UL)
+#define CYRET_SUCCESS                   (0UL)
+
+/* An assertion halts the CPU on the target and aborts the simulation. */
+#define CY_ASSERT(x)                    do { if (!(x)) { abort(); } } while (0)
+#define CY_UNUSED_PARAMETER(x)          ((void)(x))
+
+/* CMSIS core registers used by scan_stats.c. Writes have no effect. */
+#define DWT                             (&sim_dwt)
+#define CoreDebug                       (&sim_core_debug)
+#define DWT_CTRL_CYCCNTENA_Msk          (1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << 24U)
+
+/* The CPU cycles of the scan latency statistics are derived from the
+ * simulated time (see sim_get_cycles).
+ */
+#define SCAN_STATS_GET_CYCLES()         sim_get_cycles()
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef uint32_t cy_rslt_t;
+typedef uint32_t cy_status;
+typedef uint8_t uint8;
+
+typedef int32_t IRQn_Type;
+
+typedef enum
+{
+    CY_SYSINT_SUCCESS
+} cy_en_sysint_status_t;
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+typedef enum
+{
+    CY_SYSPM_SUCCESS,
+    CY_SYSPM_FAIL
+} cy_en_syspm_status_t;
+
+typedef enum
+{
+    CY_SYSPM_CHECK_READY,
+    CY_SYSPM_CHECK_FAIL,
+    CY_SYSPM_BEFORE_TRANSITION,
+    CY_SYSPM_AFTER_TRANSITION
+} cy_en_syspm_callback_mode_t;
+
+typedef enum
+{
+    CY_SYSPM_SLEEP,
+    CY_SYSPM_DEEPSLEEP
+} cy_en_syspm_callback_type_t;
+
+typedef struct
+{
+    void *base;
+    void *context;
+} cy_stc_syspm_callback_params_t;
+
+typedef cy_en_syspm_status_t (*Cy_SysPmCallback)(cy_stc_syspm_callback_params_t *callbackParams,
+                                                 cy_en_syspm_callback_mode_t mode);
+
+typedef struct
+{
+    uint32_t CTRL;
+    uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct cy_stc_syspm_callback
+{
+    Cy_SysPmCallback callback;
+    cy_en_syspm_callback_type_t type;
+    uint32_t skipMode;
+    cy_stc_syspm_callback_params_t *callbackParams;
+    struct cy_stc_syspm_callback *prevItm;
+    struct cy_stc_syspm_callback *nextItm;
+} cy_stc_syspm_callback_t;
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+extern uint32_t SystemCoreClock;
+extern DWT_Type sim_dwt;
+extern CoreDebug_Type sim_core_debug;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* The simulation is single-threaded and interrupts are dispatched only while
+ * the simulated time advances, so critical sections have no effect.
+ */
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, void (*userIsr)(void));
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler);
+
+uint32_t sim_get_cycles(void);
+
+
+#endif /* HOST_SIM_CY_PDL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,176 @@
+/******************************************************************************
+* File Name:   cycfg_capsense.h
+*
+* Description: Host stand-in for the CapSense configuration and the parts of the
+*              CapSense middleware API used by the application. The widgets mirror
+*              LinearSlider0 and GangedSensor of design.cycapsense.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_SIM_CYCFG_CAPSENSE_H
+#define HOST_SIM_CYCFG_CAPSENSE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CY_CAPSENSE_LINEARSLIDER0_WDGT_ID   (0u)
+#define CY_CAPSENSE_GANGEDSENSOR_WDGT_ID    (1u)
+#define CY_CAPSENSE_WIDGET_COUNT            (2u)
+#define CY_CAPSENSE_TOTAL_WIDGET_COUNT      (2u)
+#define CY_CAPSENSE_LINEARSLIDER0_SNS_COUNT (5u)
+#define CY_CAPSENSE_SENSOR_COUNT            (6u)
+
+#define CY_CAPSENSE_NOT_BUSY                (0u)
+#define CY_CAPSENSE_SW_STS_BUSY             (0x80u)
+
+#define CY_CAPSENSE_END_OF_SCAN_E           (0u)
+#define CY_CAPSENSE_START_SAMPLE_E          (1u)
+
+#define CY_CAPSENSE_PROCESS_FILTER          (0x01u)
+#define CY_CAPSENSE_PROCESS_BASELINE        (0x02u)
+#define CY_CAPSENSE_PROCESS_DIFFCOUNTS      (0x04u)
+#define CY_CAPSENSE_PROCESS_CALC_NOISE      (0x08u)
+#define CY_CAPSENSE_PROCESS_THRESHOLDS      (0x10u)
+#define CY_CAPSENSE_PROCESS_DECONVOLUTION   (0x20u)
+#define CY_CAPSENSE_PROCESS_STATUS          (0x40u)
+#define CY_CAPSENSE_PROCESS_ALL             (0x7Fu)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint16_t x;
+    uint16_t y;
+    uint16_t z;
+} cy_stc_capsense_position_t;
+
+typedef struct
+{
+    cy_stc_capsense_position_t *ptrPosition;
+    uint8_t numPosition;
+} cy_stc_capsense_touch_t;
+
+typedef struct
+{
+    uint16_t raw;
+    uint16_t bsln;
+    uint16_t diff;
+    uint8_t status;
+    uint8_t participate;
+    uint8_t bslnExt;
+} cy_stc_capsense_sensor_context_t;
+
+typedef struct
+{
+    uint16_t fingerTh;
+    uint16_t proxTh;
+    uint16_t noiseTh;
+    uint16_t nNoiseTh;
+    uint16_t hysteresis;
+    uint8_t onDebounce;
+    uint8_t status;
+    cy_stc_capsense_touch_t wdTouch;
+} cy_stc_capsense_widget_context_t;
+
+typedef struct
+{
+    cy_stc_capsense_widget_context_t *ptrWdContext;
+    cy_stc_capsense_sensor_context_t *ptrSnsContext;
+    uint16_t numSns;
+    uint16_t xResolution;
+} cy_stc_capsense_widget_config_t;
+
+typedef struct
+{
+    uint16_t scanCounter;
+} cy_stc_capsense_common_context_t;
+
+typedef struct
+{
+    const cy_stc_capsense_widget_config_t *ptrWdConfig;
+    cy_stc_capsense_common_context_t *ptrCommonContext;
+} cy_stc_capsense_context_t;
+
+typedef struct
+{
+    uint16_t widgetIndex;
+    uint16_t sensorIndex;
+} cy_stc_active_scan_sns_t;
+
+typedef void (*cy_capsense_callback_t)(cy_stc_active_scan_sns_t *ptrActiveScan);
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+extern cy_stc_capsense_context_t cy_capsense_context;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_status Cy_CapSense_Init(cy_stc_capsense_context_t *context);
+cy_status Cy_CapSense_Enable(cy_stc_capsense_context_t *context);
+cy_status Cy_CapSense_RegisterCallback(uint32_t callbackType, cy_capsense_callback_t callbackFunction,
+                                       cy_stc_capsense_context_t *context);
+cy_en_syspm_status_t Cy_CapSense_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams,
+                                                   cy_en_syspm_callback_mode_t mode);
+void Cy_CapSense_InterruptHandler(void *base, cy_stc_capsense_context_t *context);
+
+cy_status Cy_CapSense_SetupWidget(uint32_t widgetId, cy_stc_capsense_context_t *context);
+cy_status Cy_CapSense_Scan(cy_stc_capsense_context_t *context);
+uint32_t Cy_CapSense_IsBusy(const cy_stc_capsense_context_t *context);
+
+cy_status Cy_CapSense_ProcessWidget(uint32_t widgetId, cy_stc_capsense_context_t *context);
+cy_status Cy_CapSense_ProcessWidgetExt(uint32_t widgetId, uint32_t mode,
+                                       cy_stc_capsense_context_t *context);
+uint32_t Cy_CapSense_IsWidgetActive(uint32_t widgetId, const cy_stc_capsense_context_t *context);
+cy_stc_capsense_touch_t *Cy_CapSense_GetTouchInfo(uint32_t widgetId,
+                                                  const cy_stc_capsense_context_t *context);
+
+
+#endif /* HOST_SIM_CYCFG_CAPSENSE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,163 @@
+/******************************************************************************
+* File Name:   cyhal.h
+*
+* Description: Host stand-in for the HAL drivers used by the application sources
+*              that are compiled into the host simulation.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_SIM_CYHAL_H
+#define HOST_SIM_CYHAL_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t match;
+    bool is_event_enabled;
+} cyhal_lptimer_t;
+
+typedef enum
+{
+    CYHAL_LPTIMER_COMPARE_MATCH
+} cyhal_lptimer_event_t;
+
+typedef void (*cyhal_lptimer_event_callback_t)(void *callback_arg, cyhal_lptimer_event_t event);
+
+typedef struct
+{
+    uint32_t reserved;
+} cyhal_uart_t;
+
+typedef uint32_t cyhal_gpio_t;
+
+typedef struct
+{
+    uint32_t reserved;
+} cyhal_clock_t;
+
+typedef struct
+{
+    uint32_t reserved;
+} cyhal_ezi2c_t;
+
+typedef enum
+{
+    CYHAL_EZI2C_DATA_RATE_100KHZ,
+    CYHAL_EZI2C_DATA_RATE_400KHZ,
+    CYHAL_EZI2C_DATA_RATE_1MHZ
+} cyhal_ezi2c_data_rate_t;
+
+typedef enum
+{
+    CYHAL_EZI2C_SUB_ADDR8_BITS,
+    CYHAL_EZI2C_SUB_ADDR16_BITS
+} cyhal_ezi2c_sub_addr_size_t;
+
+typedef enum
+{
+    CYHAL_EZI2C_STATUS_READ1 = 1U << 0U,
+    CYHAL_EZI2C_STATUS_WRITE1 = 1U << 1U,
+    CYHAL_EZI2C_STATUS_READ2 = 1U << 2U,
+    CYHAL_EZI2C_STATUS_WRITE2 = 1U << 3U,
+    CYHAL_EZI2C_STATUS_BUSY = 1U << 4U,
+    CYHAL_EZI2C_STATUS_ERR = 1U << 5U
+} cyhal_ezi2c_status_t;
+
+typedef void (*cyhal_ezi2c_event_callback_t)(void *callback_arg, cyhal_ezi2c_status_t event);
+
+typedef struct
+{
+    uint8_t slave_address;
+    uint8_t *buf;
+    uint32_t buf_size;
+    uint32_t buf_rw_boundary;
+} cyhal_ezi2c_slave_cfg_t;
+
+typedef struct
+{
+    bool two_addresses;
+    bool enable_wake_from_sleep;
+    cyhal_ezi2c_data_rate_t data_rate;
+    cyhal_ezi2c_slave_cfg_t slave1_cfg;
+    cyhal_ezi2c_slave_cfg_t slave2_cfg;
+    cyhal_ezi2c_sub_addr_size_t sub_address_size;
+} cyhal_ezi2c_cfg_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* The LPTimer counts CLK_LF of the simulated clock. */
+cy_rslt_t cyhal_lptimer_init(cyhal_lptimer_t *obj);
+uint32_t cyhal_lptimer_read(const cyhal_lptimer_t *obj);
+cy_rslt_t cyhal_lptimer_set_match(cyhal_lptimer_t *obj, uint32_t value);
+void cyhal_lptimer_register_callback(cyhal_lptimer_t *obj,
+                                     cyhal_lptimer_event_callback_t callback,
+                                     void *callback_arg);
+void cyhal_lptimer_enable_event(cyhal_lptimer_t *obj, cyhal_lptimer_event_t event,
+                                uint8_t intr_priority, bool enable);
+
+/* The deep sleep lock decides between CPU sleep and system deep sleep when
+ * the simulated system is idle.
+ */
+void cyhal_syspm_lock_deepsleep(void);
+void cyhal_syspm_unlock_deepsleep(void);
+
+/* No characters are ever received on the debug UART. */
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj);
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout);
+
+/* No host ever addresses the EZI2C slave. */
+cy_rslt_t cyhal_ezi2c_init(cyhal_ezi2c_t *obj, cyhal_gpio_t sda, cyhal_gpio_t scl,
+                           const cyhal_clock_t *clk, const cyhal_ezi2c_cfg_t *cfg);
+void cyhal_ezi2c_register_callback(cyhal_ezi2c_t *obj, cyhal_ezi2c_event_callback_t callback,
+                                   void *callback_arg);
+void cyhal_ezi2c_enable_event(cyhal_ezi2c_t *obj, cyhal_ezi2c_status_t event,
+                              uint8_t intr_priority, bool enable);
+
+
+#endif /* HOST_SIM_CYHAL_H */
+
+/* [] END OF FILE */
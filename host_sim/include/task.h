@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name:   task.h
+*
+* Description: Host stand-in for the FreeRTOS task API.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_SIM_TASK_H
+#define HOST_SIM_TASK_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "FreeRTOS.h"
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *pvParameters);
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+typedef enum
+{
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+/* Only the fields maintained by the simulation. */
+typedef struct
+{
+    TaskHandle_t xHandle;
+    eTaskState eCurrentState;
+    uint32_t ulRunTimeCounter;
+} TaskStatus_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+void vTaskDelay(const TickType_t xTicksToDelay);
+
+/* Blocking calls run the simulated system, i.e. the timer daemon, the
+ * interrupts and the idle task, until the calling task is unblocked.
+ */
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+                           uint32_t *pulNotificationValue, TickType_t xTicksToWait);
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                              BaseType_t *pxHigherPriorityTaskWoken);
+
+/* The run time of a task is in CLK_LF cycles, as with the LPTimer time base of
+ * runtime_stats.c: the active time for capsense_task, and the time in CPU
+ * sleep and system deep sleep for the idle task.
+ */
+TaskHandle_t xTaskGetIdleTaskHandle(void);
+void vTaskGetInfo(TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace,
+                  eTaskState eState);
+
+
+#endif /* HOST_SIM_TASK_H */
+
+/* [] END OF FILE */
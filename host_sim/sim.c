@@ -0,0 +1,413 @@
+/******************************************************************************
+* File Name:   sim.c
+*
+* Description: Discrete-event core of the host simulation. The simulated CPU runs
+*              the task until it blocks; the idle task then enters CPU sleep or system
+*              deep sleep, depending on the deep sleep lock, until the next event.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "sim.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_MAX_SYSPM_CALLBACKS         (8U)
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static uint64_t sim_time_us;
+static uint64_t sim_end_time_us;
+static jmp_buf *sim_end_jump;
+
+static sim_event_t *sim_events[SIM_MAX_EVENTS];
+static uint32_t sim_num_events;
+
+static cy_stc_syspm_callback_t *sim_syspm_callbacks[SIM_MAX_SYSPM_CALLBACKS];
+static uint32_t sim_num_syspm_callbacks;
+static uint32_t sim_deepsleep_lock_count;
+
+static uint32_t sim_handler_depth;
+
+static uint64_t sim_mode_time_us[SIM_NUM_MODES];
+static uint32_t sim_wakeup_count;
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static sim_event_t *get_next_event(bool is_interrupt_only);
+static void dispatch_event(sim_event_t *event);
+static void idle_until(uint64_t time_us);
+static bool call_syspm_callbacks(cy_en_syspm_callback_type_t type, cy_en_syspm_callback_mode_t mode);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: sim_init
+********************************************************************************
+* Summary: Starts the simulated time at 0. The simulation ends by a long jump
+* to end_jump when the system would be woken at or after end_time_us.
+*
+*******************************************************************************/
+void sim_init(uint64_t end_time_us, jmp_buf *end_jump)
+{
+    sim_time_us = 0U;
+    sim_end_time_us = end_time_us;
+    sim_end_jump = end_jump;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_get_time_us
+********************************************************************************
+* Summary: Returns the simulated time.
+*
+*******************************************************************************/
+uint64_t sim_get_time_us(void)
+{
+    return sim_time_us;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_register_event
+********************************************************************************
+* Summary: Adds an event source. The event is initially not armed.
+*
+*******************************************************************************/
+void sim_register_event(sim_event_t *event)
+{
+    CY_ASSERT(SIM_MAX_EVENTS > sim_num_events);
+
+    event->is_armed = false;
+    sim_events[sim_num_events++] = event;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_arm_event
+********************************************************************************
+* Summary: Schedules the event at time_us. An event in the past is handled as
+* soon as possible.
+*
+*******************************************************************************/
+void sim_arm_event(sim_event_t *event, uint64_t time_us)
+{
+    event->time_us = time_us;
+    event->is_armed = true;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_disarm_event
+********************************************************************************
+* Summary: Cancels the event.
+*
+*******************************************************************************/
+void sim_disarm_event(sim_event_t *event)
+{
+    event->is_armed = false;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_run_active
+********************************************************************************
+* Summary: Accounts for duration_us of CPU activity of the task. The interrupt
+* events that fall into the activity are handled at their time.
+*
+*******************************************************************************/
+void sim_run_active(uint32_t duration_us)
+{
+    uint64_t end_us = sim_time_us + duration_us;
+    sim_event_t *event;
+
+    for (;;)
+    {
+        event = get_next_event(true);
+        if ((NULL == event) || (event->time_us > end_us))
+        {
+            break;
+        }
+
+        if (event->time_us > sim_time_us)
+        {
+            sim_mode_time_us[SIM_MODE_ACTIVE] += event->time_us - sim_time_us;
+            sim_time_us = event->time_us;
+        }
+        dispatch_event(event);
+    }
+
+    sim_mode_time_us[SIM_MODE_ACTIVE] += end_us - sim_time_us;
+    sim_time_us = end_us;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_block
+********************************************************************************
+* Summary: Blocks the task until is_unblocked returns true. Meanwhile, the
+* events are handled in time order and the system is idle between them. The
+* simulation ends here once the next wake-up is past the end time.
+*
+*******************************************************************************/
+void sim_block(bool (*is_unblocked)(void))
+{
+    sim_event_t *event;
+
+    while (!is_unblocked())
+    {
+        event = get_next_event(false);
+
+        if ((NULL == event) || (event->time_us >= sim_end_time_us))
+        {
+            idle_until(sim_end_time_us);
+            longjmp(*sim_end_jump, 1);
+        }
+
+        if (event->time_us > sim_time_us)
+        {
+            idle_until(event->time_us);
+        }
+        dispatch_event(event);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: sim_lock_deepsleep
+********************************************************************************
+* Summary: Prevents the idle task from entering system deep sleep.
+*
+*******************************************************************************/
+void sim_lock_deepsleep(void)
+{
+    sim_deepsleep_lock_count++;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_unlock_deepsleep
+********************************************************************************
+* Summary: Releases a lock taken by sim_lock_deepsleep.
+*
+*******************************************************************************/
+void sim_unlock_deepsleep(void)
+{
+    CY_ASSERT(0U != sim_deepsleep_lock_count);
+
+    sim_deepsleep_lock_count--;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_register_syspm_callback
+********************************************************************************
+* Summary: Adds a SysPm callback, called on the transitions of its type in
+* registration order.
+*
+*******************************************************************************/
+void sim_register_syspm_callback(cy_stc_syspm_callback_t *handler)
+{
+    CY_ASSERT(SIM_MAX_SYSPM_CALLBACKS > sim_num_syspm_callbacks);
+
+    sim_syspm_callbacks[sim_num_syspm_callbacks++] = handler;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_is_task_context
+********************************************************************************
+* Summary: Returns false while an event handler, i.e. an interrupt or a timer
+* callback, is running.
+*
+*******************************************************************************/
+bool sim_is_task_context(void)
+{
+    return (0U == sim_handler_depth);
+}
+
+
+/*******************************************************************************
+* Function Name: sim_get_mode_time_us
+********************************************************************************
+* Summary: Returns the simulated time spent in the power mode.
+*
+*******************************************************************************/
+uint64_t sim_get_mode_time_us(sim_mode_t mode)
+{
+    return sim_mode_time_us[mode];
+}
+
+
+/*******************************************************************************
+* Function Name: sim_get_wakeup_count
+********************************************************************************
+* Summary: Returns the number of wake-ups from CPU sleep or system deep sleep.
+*
+*******************************************************************************/
+uint32_t sim_get_wakeup_count(void)
+{
+    return sim_wakeup_count;
+}
+
+
+/*******************************************************************************
+* Function Name: get_next_event
+********************************************************************************
+* Summary: Returns the armed event with the earliest time, or NULL. Events
+* with the same time are returned in registration order.
+*
+*******************************************************************************/
+static sim_event_t *get_next_event(bool is_interrupt_only)
+{
+    sim_event_t *next = NULL;
+
+    for (uint32_t i = 0; i < sim_num_events; i++)
+    {
+        sim_event_t *event = sim_events[i];
+
+        if (event->is_armed && (event->is_interrupt || !is_interrupt_only) &&
+            ((NULL == next) || (event->time_us < next->time_us)))
+        {
+            next = event;
+        }
+    }
+
+    return next;
+}
+
+
+/*******************************************************************************
+* Function Name: dispatch_event
+********************************************************************************
+* Summary: Disarms the event and calls its handler, which may arm it again.
+*
+*******************************************************************************/
+static void dispatch_event(sim_event_t *event)
+{
+    event->is_armed = false;
+
+    sim_handler_depth++;
+    event->handler();
+    sim_handler_depth--;
+}
+
+
+/*******************************************************************************
+* Function Name: idle_until
+********************************************************************************
+* Summary: Models the tickless idle of the FreeRTOS port: system deep sleep if
+* deep sleep is not locked and all the deep sleep callbacks are ready,
+* otherwise CPU sleep.
+*
+*******************************************************************************/
+static void idle_until(uint64_t time_us)
+{
+    cy_en_syspm_callback_type_t type = CY_SYSPM_SLEEP;
+    sim_mode_t mode = SIM_MODE_SLEEP;
+
+    if (time_us <= sim_time_us)
+    {
+        return;
+    }
+
+    if ((0U == sim_deepsleep_lock_count) &&
+        call_syspm_callbacks(CY_SYSPM_DEEPSLEEP, CY_SYSPM_CHECK_READY))
+    {
+        type = CY_SYSPM_DEEPSLEEP;
+        mode = SIM_MODE_DEEPSLEEP;
+    }
+    else
+    {
+        (void)call_syspm_callbacks(CY_SYSPM_SLEEP, CY_SYSPM_CHECK_READY);
+    }
+
+    (void)call_syspm_callbacks(type, CY_SYSPM_BEFORE_TRANSITION);
+    sim_mode_time_us[mode] += time_us - sim_time_us;
+    sim_time_us = time_us;
+    (void)call_syspm_callbacks(type, CY_SYSPM_AFTER_TRANSITION);
+
+    sim_wakeup_count++;
+}
+
+
+/*******************************************************************************
+* Function Name: call_syspm_callbacks
+********************************************************************************
+* Summary: Calls the callbacks of the type with mode. If a callback fails the
+* CY_SYSPM_CHECK_READY mode, the callbacks that passed it are called with
+* CY_SYSPM_CHECK_FAIL and false is returned.
+*
+*******************************************************************************/
+static bool call_syspm_callbacks(cy_en_syspm_callback_type_t type, cy_en_syspm_callback_mode_t mode)
+{
+    for (uint32_t i = 0; i < sim_num_syspm_callbacks; i++)
+    {
+        cy_stc_syspm_callback_t *handler = sim_syspm_callbacks[i];
+
+        if ((type == handler->type) &&
+            (CY_SYSPM_SUCCESS != handler->callback(handler->callbackParams, mode)) &&
+            (CY_SYSPM_CHECK_READY == mode))
+        {
+            for (uint32_t j = 0; j < i; j++)
+            {
+                if (type == sim_syspm_callbacks[j]->type)
+                {
+                    (void)sim_syspm_callbacks[j]->callback(sim_syspm_callbacks[j]->callbackParams,
+                                                           CY_SYSPM_CHECK_FAIL);
+                }
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,126 @@
+/******************************************************************************
+* File Name:   sim.h
+*
+* Description: Discrete-event core of the host simulation: simulated time, the
+*              interrupt and timer daemon events, and the low-power modes entered by
+*              the idle task.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_SIM_SIM_H
+#define HOST_SIM_SIM_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <setjmp.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of event sources. */
+#define SIM_MAX_EVENTS                  (8U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    SIM_MODE_ACTIVE,
+    SIM_MODE_SLEEP,
+    SIM_MODE_DEEPSLEEP,
+    SIM_NUM_MODES
+} sim_mode_t;
+
+/* Event source. An interrupt event preempts the task at its time. A daemon
+ * event, e.g. a FreeRTOS software timer, runs at its time if the task is
+ * blocked, or as soon as the task blocks.
+ */
+typedef struct
+{
+    bool is_interrupt;
+    bool is_armed;
+    uint64_t time_us;
+    void (*handler)(void);
+} sim_event_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void sim_init(uint64_t end_time_us, jmp_buf *end_jump);
+uint64_t sim_get_time_us(void);
+void sim_register_event(sim_event_t *event);
+void sim_arm_event(sim_event_t *event, uint64_t time_us);
+void sim_disarm_event(sim_event_t *event);
+
+void sim_run_active(uint32_t duration_us);
+void sim_block(bool (*is_unblocked)(void));
+
+void sim_lock_deepsleep(void);
+void sim_unlock_deepsleep(void);
+void sim_register_syspm_callback(cy_stc_syspm_callback_t *handler);
+
+bool sim_is_task_context(void);
+
+uint64_t sim_get_mode_time_us(sim_mode_t mode);
+uint32_t sim_get_wakeup_count(void);
+
+/* FreeRTOS stand-in (sim_rtos.c) */
+uint32_t sim_rtos_get_task_wakeup_count(void);
+TaskHandle_t sim_rtos_get_task_handle(void);
+
+/* Touch trace (sim_trace.c) */
+bool sim_trace_load(const char *path);
+uint64_t sim_trace_get_end_time_us(void);
+bool sim_trace_get_touch(uint64_t time_us, uint16_t *position);
+
+/* CapSense middleware stand-in (sim_capsense.c) */
+uint32_t sim_capsense_get_scan_count(uint32_t widget_id);
+uint32_t sim_capsense_get_process_count(uint32_t widget_id);
+uint32_t sim_capsense_get_average_current_na(void);
+
+
+#endif /* HOST_SIM_SIM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,635 @@
+/******************************************************************************
+* File Name:   sim_capsense.c
+*
+* Description: Stand-in for the CapSense middleware. The raw counts of every scan
+*              are synthesized from the touch trace, and the processing follows the
+*              structure of the middleware: baseline, difference counts, touch status
+*              with hysteresis, and a 3x3 centroid for the slider.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cycfg_capsense.h"
+
+#include "energy_model.h"
+#include "sim.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Thresholds of LinearSlider0 and GangedSensor in design.cycapsense of
+ * CY8CKIT-062-BLE.
+ */
+#define SIM_FINGER_TH                   (10U)
+#define SIM_NOISE_TH                    (5U)
+#define SIM_HYSTERESIS                  (1U)
+#define SIM_SLIDER_RESOLUTION           (300U)
+
+/* Synthesized raw counts: baseline level, peak signal of a finger, and the
+ * peak-to-peak noise, in counts.
+ */
+#define SIM_BASELINE                    (250U)
+#define SIM_FINGER_SIGNAL               (60U)
+#define SIM_NOISE_P2P                   (4U)
+
+/* Scan and processing durations. The full processing takes the time of the
+ * energy model; baseline and difference counts only are assumed to take
+ * SIM_PARTIAL_PROCESS_PERCENT of it. Cy_CapSense_IsBusy polled by the task
+ * while a scan is in progress costs SIM_BUSY_POLL_US.
+ */
+#define SIM_PARTIAL_PROCESS_PERCENT     (30U)
+#define SIM_BUSY_POLL_US                (10U)
+
+/* The baseline follows the raw count with a coefficient of
+ * 2^-SIM_BASELINE_IIR_SHIFT while the signal is below the noise threshold.
+ */
+#define SIM_BASELINE_IIR_SHIFT          (2U)
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static cy_stc_capsense_sensor_context_t slider_sensors[CY_CAPSENSE_LINEARSLIDER0_SNS_COUNT];
+static cy_stc_capsense_sensor_context_t ganged_sensors[1];
+static cy_stc_capsense_position_t slider_position;
+
+static cy_stc_capsense_widget_context_t widget_contexts[CY_CAPSENSE_WIDGET_COUNT] =
+{
+    [CY_CAPSENSE_LINEARSLIDER0_WDGT_ID] =
+    {
+        .fingerTh       = SIM_FINGER_TH,
+        .noiseTh        = SIM_NOISE_TH,
+        .nNoiseTh       = SIM_NOISE_TH,
+        .hysteresis     = SIM_HYSTERESIS,
+        .onDebounce     = 1U,
+        .wdTouch        = { .ptrPosition = &slider_position }
+    },
+    [CY_CAPSENSE_GANGEDSENSOR_WDGT_ID] =
+    {
+        .fingerTh       = SIM_FINGER_TH,
+        .noiseTh        = SIM_NOISE_TH,
+        .nNoiseTh       = SIM_NOISE_TH,
+        .hysteresis     = SIM_HYSTERESIS,
+        .onDebounce     = 1U
+    }
+};
+
+static const cy_stc_capsense_widget_config_t widget_configs[CY_CAPSENSE_WIDGET_COUNT] =
+{
+    [CY_CAPSENSE_LINEARSLIDER0_WDGT_ID] =
+    {
+        .ptrWdContext   = &widget_contexts[CY_CAPSENSE_LINEARSLIDER0_WDGT_ID],
+        .ptrSnsContext  = slider_sensors,
+        .numSns         = CY_CAPSENSE_LINEARSLIDER0_SNS_COUNT,
+        .xResolution    = SIM_SLIDER_RESOLUTION
+    },
+    [CY_CAPSENSE_GANGEDSENSOR_WDGT_ID] =
+    {
+        .ptrWdContext   = &widget_contexts[CY_CAPSENSE_GANGEDSENSOR_WDGT_ID],
+        .ptrSnsContext  = ganged_sensors,
+        .numSns         = 1U,
+        .xResolution    = 0U
+    }
+};
+
+static const energy_model_widget_t widget_timings[CY_CAPSENSE_WIDGET_COUNT] =
+{
+    [CY_CAPSENSE_LINEARSLIDER0_WDGT_ID] =
+    {
+        .scan_time_us       = ENERGY_MODEL_SLIDER_SCAN_TIME_US,
+        .process_time_us    = ENERGY_MODEL_SLIDER_PROCESS_TIME_US
+    },
+    [CY_CAPSENSE_GANGEDSENSOR_WDGT_ID] =
+    {
+        .scan_time_us       = ENERGY_MODEL_GANGED_SCAN_TIME_US,
+        .process_time_us    = ENERGY_MODEL_GANGED_PROCESS_TIME_US
+    }
+};
+
+static cy_stc_capsense_common_context_t common_context;
+
+cy_stc_capsense_context_t cy_capsense_context =
+{
+    .ptrWdConfig        = widget_configs,
+    .ptrCommonContext   = &common_context
+};
+
+static cy_capsense_callback_t end_of_scan_callback;
+static uint32_t setup_widget_id;
+static bool is_busy;
+static uint32_t scan_counts[CY_CAPSENSE_WIDGET_COUNT];
+static uint32_t process_counts[CY_CAPSENSE_WIDGET_COUNT];
+static uint32_t noise_state = 1U;
+
+/* Energy model fed with the scans of the simulation. The scans started without
+ * deep sleep in between form a batch, accounted over the time to the next
+ * batch with the simulated CPU sleep and active time of that period, so that
+ * the processing paths of the application are measured rather than assumed.
+ */
+static energy_model_t energy_model;
+static uint32_t num_batch_widgets;
+static uint64_t batch_start_us;
+static uint64_t batch_deepsleep_us;
+static uint64_t batch_sleep_us;
+static uint64_t batch_active_us;
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void synthesize_raw_counts(uint32_t widget_id);
+static uint16_t get_noise(void);
+static void process_widget(uint32_t widget_id, uint32_t mode);
+static uint16_t get_centroid(const cy_stc_capsense_widget_config_t *widget_config);
+static void handle_end_of_scan(void);
+static void record_batch(void);
+
+static sim_event_t end_of_scan_event = { .is_interrupt = true, .handler = handle_end_of_scan };
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_Init
+********************************************************************************
+* Summary: Starts every sensor at the baseline level and resets the energy
+* model.
+*
+*******************************************************************************/
+cy_status Cy_CapSense_Init(cy_stc_capsense_context_t *context)
+{
+    for (uint32_t widget_id = 0; widget_id < CY_CAPSENSE_WIDGET_COUNT; widget_id++)
+    {
+        const cy_stc_capsense_widget_config_t *widget_config = &context->ptrWdConfig[widget_id];
+
+        for (uint32_t i = 0; i < widget_config->numSns; i++)
+        {
+            widget_config->ptrSnsContext[i].raw = SIM_BASELINE;
+            widget_config->ptrSnsContext[i].bsln = SIM_BASELINE;
+            widget_config->ptrSnsContext[i].diff = 0U;
+        }
+    }
+
+    energy_model_init(&energy_model, widget_timings, CY_CAPSENSE_WIDGET_COUNT);
+    sim_register_event(&end_of_scan_event);
+
+    return CYRET_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_Enable
+*******************************************************************************/
+cy_status Cy_CapSense_Enable(cy_stc_capsense_context_t *context)
+{
+    (void)context;
+
+    return CYRET_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_RegisterCallback
+*******************************************************************************/
+cy_status Cy_CapSense_RegisterCallback(uint32_t callbackType, cy_capsense_callback_t callbackFunction,
+                                       cy_stc_capsense_context_t *context)
+{
+    (void)context;
+
+    if (CY_CAPSENSE_END_OF_SCAN_E == callbackType)
+    {
+        end_of_scan_callback = callbackFunction;
+    }
+
+    return CYRET_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_DeepSleepCallback
+********************************************************************************
+* Summary: Like the middleware, deep sleep is refused while a scan is in
+* progress.
+*
+*******************************************************************************/
+cy_en_syspm_status_t Cy_CapSense_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams,
+                                                   cy_en_syspm_callback_mode_t mode)
+{
+    (void)callbackParams;
+
+    return ((CY_SYSPM_CHECK_READY == mode) && is_busy) ? CY_SYSPM_FAIL : CY_SYSPM_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_InterruptHandler
+********************************************************************************
+* Summary: Not used; the end of a simulated scan calls the end-of-scan
+* callback directly.
+*
+*******************************************************************************/
+void Cy_CapSense_InterruptHandler(void *base, cy_stc_capsense_context_t *context)
+{
+    (void)base;
+    (void)context;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_SetupWidget
+*******************************************************************************/
+cy_status Cy_CapSense_SetupWidget(uint32_t widgetId, cy_stc_capsense_context_t *context)
+{
+    (void)context;
+
+    CY_ASSERT(CY_CAPSENSE_WIDGET_COUNT > widgetId);
+    setup_widget_id = widgetId;
+
+    return CYRET_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_Scan
+********************************************************************************
+* Summary: Starts a scan of the widget set up last. The end-of-scan interrupt
+* occurs after the scan time of the widget.
+*
+*******************************************************************************/
+cy_status Cy_CapSense_Scan(cy_stc_capsense_context_t *context)
+{
+    (void)context;
+
+    CY_ASSERT(!is_busy);
+
+    uint64_t deepsleep_us = sim_get_mode_time_us(SIM_MODE_DEEPSLEEP);
+
+    if ((0U != num_batch_widgets) &&
+        ((batch_deepsleep_us != deepsleep_us) || (CY_CAPSENSE_WIDGET_COUNT == num_batch_widgets)))
+    {
+        record_batch();
+    }
+    if (0U == num_batch_widgets)
+    {
+        batch_start_us = sim_get_time_us();
+        batch_sleep_us = sim_get_mode_time_us(SIM_MODE_SLEEP);
+        batch_active_us = sim_get_mode_time_us(SIM_MODE_ACTIVE);
+    }
+    num_batch_widgets++;
+    batch_deepsleep_us = deepsleep_us;
+
+    is_busy = true;
+    scan_counts[setup_widget_id]++;
+    sim_arm_event(&end_of_scan_event, sim_get_time_us() + widget_timings[setup_widget_id].scan_time_us);
+
+    return CYRET_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_IsBusy
+********************************************************************************
+* Summary: Returns whether a scan is in progress. Polling from the task takes
+* CPU time, so that a busy-wait loop advances the simulated time.
+*
+*******************************************************************************/
+uint32_t Cy_CapSense_IsBusy(const cy_stc_capsense_context_t *context)
+{
+    (void)context;
+
+    if (is_busy && sim_is_task_context())
+    {
+        sim_run_active(SIM_BUSY_POLL_US);
+    }
+
+    return is_busy ? CY_CAPSENSE_SW_STS_BUSY : CY_CAPSENSE_NOT_BUSY;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_ProcessWidget
+*******************************************************************************/
+cy_status Cy_CapSense_ProcessWidget(uint32_t widgetId, cy_stc_capsense_context_t *context)
+{
+    (void)context;
+
+    sim_run_active(widget_timings[widgetId].process_time_us);
+    process_counts[widgetId]++;
+    process_widget(widgetId, CY_CAPSENSE_PROCESS_ALL);
+
+    return CYRET_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_ProcessWidgetExt
+*******************************************************************************/
+cy_status Cy_CapSense_ProcessWidgetExt(uint32_t widgetId, uint32_t mode,
+                                       cy_stc_capsense_context_t *context)
+{
+    (void)context;
+
+    sim_run_active((widget_timings[widgetId].process_time_us * SIM_PARTIAL_PROCESS_PERCENT) / 100U);
+    process_widget(widgetId, mode);
+
+    return CYRET_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_IsWidgetActive
+*******************************************************************************/
+uint32_t Cy_CapSense_IsWidgetActive(uint32_t widgetId, const cy_stc_capsense_context_t *context)
+{
+    return context->ptrWdConfig[widgetId].ptrWdContext->status;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_GetTouchInfo
+*******************************************************************************/
+cy_stc_capsense_touch_t *Cy_CapSense_GetTouchInfo(uint32_t widgetId,
+                                                  const cy_stc_capsense_context_t *context)
+{
+    return &context->ptrWdConfig[widgetId].ptrWdContext->wdTouch;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_capsense_get_scan_count
+********************************************************************************
+* Summary: Returns the number of scans of the widget started so far.
+*
+*******************************************************************************/
+uint32_t sim_capsense_get_scan_count(uint32_t widget_id)
+{
+    return (CY_CAPSENSE_WIDGET_COUNT > widget_id) ? scan_counts[widget_id] : 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_capsense_get_process_count
+********************************************************************************
+* Summary: Returns the number of full processings of the widget so far, by
+* Cy_CapSense_ProcessWidget.
+*
+*******************************************************************************/
+uint32_t sim_capsense_get_process_count(uint32_t widget_id)
+{
+    return (CY_CAPSENSE_WIDGET_COUNT > widget_id) ? process_counts[widget_id] : 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_capsense_get_average_current_na
+********************************************************************************
+* Summary: Returns the average current of the energy model over the scans so
+* far, with the last batch accounted up to the current time.
+*
+*******************************************************************************/
+uint32_t sim_capsense_get_average_current_na(void)
+{
+    if (0U != num_batch_widgets)
+    {
+        record_batch();
+    }
+
+    return energy_model_get_average_current_na(&energy_model);
+}
+
+
+/*******************************************************************************
+* Function Name: synthesize_raw_counts
+********************************************************************************
+* Summary: Sets the raw counts of the widget from the touch trace. A finger on
+* the slider couples into the two nearest slider segments in proportion to
+* its distance from their centers; the Ganged Sensor sees the full signal.
+*
+*******************************************************************************/
+static void synthesize_raw_counts(uint32_t widget_id)
+{
+    const cy_stc_capsense_widget_config_t *widget_config = &cy_capsense_context.ptrWdConfig[widget_id];
+    uint16_t position = 0U;
+    bool is_touched = sim_trace_get_touch(sim_get_time_us(), &position);
+    uint32_t pitch = SIM_SLIDER_RESOLUTION / (CY_CAPSENSE_LINEARSLIDER0_SNS_COUNT - 1U);
+
+    for (uint32_t i = 0; i < widget_config->numSns; i++)
+    {
+        uint32_t signal = 0U;
+
+        if (is_touched && (CY_CAPSENSE_GANGEDSENSOR_WDGT_ID == widget_id))
+        {
+            signal = SIM_FINGER_SIGNAL;
+        }
+        else if (is_touched)
+        {
+            uint32_t center = i * pitch;
+            uint32_t distance = (position > center) ? (position - center) : (center - position);
+
+            signal = (distance < pitch) ? ((SIM_FINGER_SIGNAL * (pitch - distance)) / pitch) : 0U;
+        }
+
+        widget_config->ptrSnsContext[i].raw = (uint16_t)(SIM_BASELINE + signal + get_noise() -
+                                                         (SIM_NOISE_P2P / 2U));
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: get_noise
+********************************************************************************
+* Summary: Returns a pseudo-random value in [0, SIM_NOISE_P2P]. The sequence is
+* the same in every run.
+*
+*******************************************************************************/
+static uint16_t get_noise(void)
+{
+    noise_state = (noise_state * 1103515245U) + 12345U;
+
+    return (uint16_t)((noise_state >> 16) % (SIM_NOISE_P2P + 1U));
+}
+
+
+/*******************************************************************************
+* Function Name: process_widget
+********************************************************************************
+* Summary: Performs the processing steps selected by mode on the widget.
+*
+*******************************************************************************/
+static void process_widget(uint32_t widget_id, uint32_t mode)
+{
+    const cy_stc_capsense_widget_config_t *widget_config = &cy_capsense_context.ptrWdConfig[widget_id];
+    cy_stc_capsense_widget_context_t *widget_context = widget_config->ptrWdContext;
+    uint16_t max_diff = 0U;
+
+    for (uint32_t i = 0; i < widget_config->numSns; i++)
+    {
+        cy_stc_capsense_sensor_context_t *sensor = &widget_config->ptrSnsContext[i];
+        int32_t delta = (int32_t)sensor->raw - (int32_t)sensor->bsln;
+
+        if ((0U != (mode & CY_CAPSENSE_PROCESS_BASELINE)) &&
+            (delta < (int32_t)widget_context->noiseTh))
+        {
+            sensor->bsln = (uint16_t)((int32_t)sensor->bsln + (delta / (1 << SIM_BASELINE_IIR_SHIFT)));
+            delta = (int32_t)sensor->raw - (int32_t)sensor->bsln;
+        }
+
+        if (0U != (mode & CY_CAPSENSE_PROCESS_DIFFCOUNTS))
+        {
+            sensor->diff = (delta > 0) ? (uint16_t)delta : 0U;
+        }
+
+        if (sensor->diff > max_diff)
+        {
+            max_diff = sensor->diff;
+        }
+    }
+
+    if (0U == (mode & CY_CAPSENSE_PROCESS_STATUS))
+    {
+        return;
+    }
+
+    if (0U != widget_context->status)
+    {
+        widget_context->status = ((uint32_t)max_diff + widget_context->hysteresis >= widget_context->fingerTh) ? 1U : 0U;
+    }
+    else
+    {
+        widget_context->status = ((uint32_t)max_diff >= (uint32_t)widget_context->fingerTh + widget_context->hysteresis) ? 1U : 0U;
+    }
+
+    widget_context->wdTouch.numPosition = 0U;
+    if ((0U != widget_context->status) && (0U != widget_config->xResolution))
+    {
+        widget_context->wdTouch.ptrPosition->x = get_centroid(widget_config);
+        widget_context->wdTouch.numPosition = 1U;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: get_centroid
+********************************************************************************
+* Summary: Returns the 3x3 centroid of a linear slider around the sensor with
+* the largest difference count.
+*
+*******************************************************************************/
+static uint16_t get_centroid(const cy_stc_capsense_widget_config_t *widget_config)
+{
+    uint32_t num_sensors = widget_config->numSns;
+    uint32_t peak = 0U;
+    int32_t prev;
+    int32_t next;
+    int32_t sum;
+    int32_t position;
+
+    for (uint32_t i = 1; i < num_sensors; i++)
+    {
+        if (widget_config->ptrSnsContext[i].diff > widget_config->ptrSnsContext[peak].diff)
+        {
+            peak = i;
+        }
+    }
+
+    prev = (0U != peak) ? widget_config->ptrSnsContext[peak - 1U].diff : 0;
+    next = ((peak + 1U) < num_sensors) ? widget_config->ptrSnsContext[peak + 1U].diff : 0;
+    sum = prev + widget_config->ptrSnsContext[peak].diff + next;
+
+    /* position = (peak + (next - prev) / sum) * resolution / (num_sensors - 1) */
+    position = (int32_t)((((int64_t)peak * sum + (next - prev)) * widget_config->xResolution) /
+                         ((int64_t)sum * (int32_t)(num_sensors - 1U)));
+
+    if (position < 0)
+    {
+        position = 0;
+    }
+    else if (position > (int32_t)widget_config->xResolution)
+    {
+        position = (int32_t)widget_config->xResolution;
+    }
+
+    return (uint16_t)position;
+}
+
+
+/*******************************************************************************
+* Function Name: handle_end_of_scan
+********************************************************************************
+* Summary: Completes the scan and calls the end-of-scan callback, which may
+* start the next scan of a batch.
+*
+*******************************************************************************/
+static void handle_end_of_scan(void)
+{
+    cy_stc_active_scan_sns_t active_scan = { .widgetIndex = (uint16_t)setup_widget_id };
+
+    synthesize_raw_counts(setup_widget_id);
+    common_context.scanCounter++;
+    is_busy = false;
+
+    if (NULL != end_of_scan_callback)
+    {
+        end_of_scan_callback(&active_scan);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: record_batch
+********************************************************************************
+* Summary: Accounts the current batch of scans in the energy model, over the
+* time from its first scan to now. The time in CPU sleep is the scan time and
+* the time with the CPU active the processing time.
+*
+*******************************************************************************/
+static void record_batch(void)
+{
+    energy_model_record_period(&energy_model,
+                               (uint32_t)(sim_get_mode_time_us(SIM_MODE_SLEEP) - batch_sleep_us),
+                               (uint32_t)(sim_get_mode_time_us(SIM_MODE_ACTIVE) - batch_active_us),
+                               (uint32_t)(sim_get_time_us() - batch_start_us));
+    num_batch_widgets = 0U;
+}
+
+
+/* [] END OF FILE */
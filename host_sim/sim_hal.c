@@ -0,0 +1,361 @@
+/******************************************************************************
+* File Name:   sim_hal.c
+*
+* Description: Simulated PDL and HAL drivers: critical sections, interrupt setup,
+*              SysPm callbacks, the deep sleep lock, the LPTimer and the debug UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cyhal.h"
+#include "cycfg.h"
+#include "cy_retarget_io.h"
+
+#include "sim.h"
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+cyhal_uart_t cy_retarget_io_uart_obj;
+
+/* CM4 clock of the kit. */
+uint32_t SystemCoreClock = 100000000UL;
+DWT_Type sim_dwt;
+CoreDebug_Type sim_core_debug;
+
+static cyhal_lptimer_t *lptimer_obj;
+static cyhal_lptimer_event_callback_t lptimer_callback;
+static void *lptimer_callback_arg;
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static uint64_t get_lptimer_ticks(void);
+static void arm_lptimer_match(void);
+static void handle_lptimer_match(void);
+
+static sim_event_t lptimer_match_event = { .is_interrupt = true, .handler = handle_lptimer_match };
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: Cy_SysLib_EnterCriticalSection
+*******************************************************************************/
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    return 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SysLib_ExitCriticalSection
+*******************************************************************************/
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    (void)savedIntrStatus;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_get_cycles
+********************************************************************************
+* Summary: Stand-in for the DWT cycle counter: the simulated time in CPU cycles,
+* wrapping around as the 32-bit counter does.
+*
+*******************************************************************************/
+uint32_t sim_get_cycles(void)
+{
+    return (uint32_t)(sim_get_time_us() * (SystemCoreClock / 1000000U));
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SysInt_Init
+********************************************************************************
+* Summary: The simulated peripherals call their handlers directly.
+*
+*******************************************************************************/
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, void (*userIsr)(void))
+{
+    (void)config;
+    (void)userIsr;
+
+    return CY_SYSINT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: NVIC_ClearPendingIRQ
+*******************************************************************************/
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    (void)IRQn;
+}
+
+
+/*******************************************************************************
+* Function Name: NVIC_EnableIRQ
+*******************************************************************************/
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    (void)IRQn;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SysPm_RegisterCallback
+*******************************************************************************/
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler)
+{
+    sim_register_syspm_callback(handler);
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_syspm_lock_deepsleep
+*******************************************************************************/
+void cyhal_syspm_lock_deepsleep(void)
+{
+    sim_lock_deepsleep();
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_syspm_unlock_deepsleep
+*******************************************************************************/
+void cyhal_syspm_unlock_deepsleep(void)
+{
+    sim_unlock_deepsleep();
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_lptimer_init
+********************************************************************************
+* Summary: The simulation has a single LPTimer, shared through lp_timer.c.
+*
+*******************************************************************************/
+cy_rslt_t cyhal_lptimer_init(cyhal_lptimer_t *obj)
+{
+    CY_ASSERT(NULL == lptimer_obj);
+
+    obj->match = 0U;
+    obj->is_event_enabled = false;
+    lptimer_obj = obj;
+    sim_register_event(&lptimer_match_event);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_lptimer_read
+*******************************************************************************/
+uint32_t cyhal_lptimer_read(const cyhal_lptimer_t *obj)
+{
+    (void)obj;
+
+    return (uint32_t)get_lptimer_ticks();
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_lptimer_set_match
+*******************************************************************************/
+cy_rslt_t cyhal_lptimer_set_match(cyhal_lptimer_t *obj, uint32_t value)
+{
+    obj->match = value;
+    arm_lptimer_match();
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_lptimer_register_callback
+*******************************************************************************/
+void cyhal_lptimer_register_callback(cyhal_lptimer_t *obj,
+                                     cyhal_lptimer_event_callback_t callback,
+                                     void *callback_arg)
+{
+    (void)obj;
+
+    lptimer_callback = callback;
+    lptimer_callback_arg = callback_arg;
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_lptimer_enable_event
+*******************************************************************************/
+void cyhal_lptimer_enable_event(cyhal_lptimer_t *obj, cyhal_lptimer_event_t event,
+                                uint8_t intr_priority, bool enable)
+{
+    (void)event;
+    (void)intr_priority;
+
+    obj->is_event_enabled = enable;
+    arm_lptimer_match();
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_uart_readable
+*******************************************************************************/
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj)
+{
+    (void)obj;
+
+    return 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_uart_getc
+*******************************************************************************/
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout)
+{
+    (void)obj;
+    (void)value;
+    (void)timeout;
+
+    return (cy_rslt_t)~CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_ezi2c_init
+*******************************************************************************/
+cy_rslt_t cyhal_ezi2c_init(cyhal_ezi2c_t *obj, cyhal_gpio_t sda, cyhal_gpio_t scl,
+                           const cyhal_clock_t *clk, const cyhal_ezi2c_cfg_t *cfg)
+{
+    (void)obj;
+    (void)sda;
+    (void)scl;
+    (void)clk;
+    (void)cfg;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_ezi2c_register_callback
+*******************************************************************************/
+void cyhal_ezi2c_register_callback(cyhal_ezi2c_t *obj, cyhal_ezi2c_event_callback_t callback,
+                                   void *callback_arg)
+{
+    (void)obj;
+    (void)callback;
+    (void)callback_arg;
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_ezi2c_enable_event
+*******************************************************************************/
+void cyhal_ezi2c_enable_event(cyhal_ezi2c_t *obj, cyhal_ezi2c_status_t event,
+                              uint8_t intr_priority, bool enable)
+{
+    (void)obj;
+    (void)event;
+    (void)intr_priority;
+    (void)enable;
+}
+
+
+/*******************************************************************************
+* Function Name: get_lptimer_ticks
+********************************************************************************
+* Summary: Returns the number of CLK_LF cycles since the start of the
+* simulation. The LPTimer counter is its lower 32 bits.
+*
+*******************************************************************************/
+static uint64_t get_lptimer_ticks(void)
+{
+    return (sim_get_time_us() * CY_CFG_SYSCLK_CLKLF_FREQ_HZ) / 1000000U;
+}
+
+
+/*******************************************************************************
+* Function Name: arm_lptimer_match
+********************************************************************************
+* Summary: Schedules the match interrupt at the first CLK_LF cycle at which
+* the counter equals the match value.
+*
+*******************************************************************************/
+static void arm_lptimer_match(void)
+{
+    uint64_t ticks = get_lptimer_ticks();
+    uint32_t ticks_to_match;
+
+    if ((NULL == lptimer_obj) || !lptimer_obj->is_event_enabled)
+    {
+        sim_disarm_event(&lptimer_match_event);
+        return;
+    }
+
+    ticks_to_match = lptimer_obj->match - (uint32_t)ticks;
+    ticks += ticks_to_match;
+    sim_arm_event(&lptimer_match_event,
+                  ((ticks * 1000000U) + CY_CFG_SYSCLK_CLKLF_FREQ_HZ - 1U) / CY_CFG_SYSCLK_CLKLF_FREQ_HZ);
+}
+
+
+/*******************************************************************************
+* Function Name: handle_lptimer_match
+*******************************************************************************/
+static void handle_lptimer_match(void)
+{
+    if (NULL != lptimer_callback)
+    {
+        lptimer_callback(lptimer_callback_arg, CYHAL_LPTIMER_COMPARE_MATCH);
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,567 @@
+/******************************************************************************
+* File Name:   sim_rtos.c
+*
+* Description: Simulated FreeRTOS kernel: the tick count, the task notification
+*              and delays of the single simulated task, and the software timers
+*              serviced by the timer daemon task.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "cycfg.h"
+
+#include "sim.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_MAX_TIMERS                  (4U)
+#define SIM_US_PER_TICK                 (1000000U / configTICK_RATE_HZ)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+struct sim_timer
+{
+    bool is_active;
+    bool is_auto_reload;
+    TickType_t period;
+    TickType_t expiry;
+    TimerCallbackFunction_t callback;
+};
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static uint32_t notification_value;
+static bool is_notification_pending;
+static bool is_timed_out;
+static uint32_t task_wakeup_count;
+
+static struct sim_timer timers[SIM_MAX_TIMERS];
+static uint32_t num_timers;
+
+static bool is_initialized;
+
+/* Task handles reported by vTaskGetInfo. */
+static uint8_t capsense_task_object;
+static uint8_t idle_task_object;
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void initialize(void);
+static void notify(uint32_t value, eNotifyAction action);
+static bool is_task_unblocked(void);
+static bool is_delay_elapsed(void);
+static void arm_timer_daemon(void);
+static uint64_t get_tick_time_us(TickType_t ticks);
+static void handle_task_timeout(void);
+static void handle_timer_daemon(void);
+
+/* The task timeout is an interrupt event since the tick interrupt unblocks
+ * the task at its time.
+ */
+static sim_event_t task_timeout_event = { .is_interrupt = true, .handler = handle_task_timeout };
+static sim_event_t timer_daemon_event = { .is_interrupt = false, .handler = handle_timer_daemon };
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: xTaskGetTickCount
+********************************************************************************
+* Summary: Returns the simulated time in ticks.
+*
+*******************************************************************************/
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(sim_get_time_us() / SIM_US_PER_TICK);
+}
+
+
+/*******************************************************************************
+* Function Name: xTaskGetTickCountFromISR
+*******************************************************************************/
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return xTaskGetTickCount();
+}
+
+
+/*******************************************************************************
+* Function Name: vTaskDelay
+********************************************************************************
+* Summary: Blocks the task for xTicksToDelay ticks.
+*
+*******************************************************************************/
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+    initialize();
+
+    is_timed_out = false;
+    sim_arm_event(&task_timeout_event, get_tick_time_us(xTicksToDelay));
+
+    /* A notification does not end the delay. */
+    sim_block(is_delay_elapsed);
+}
+
+
+/*******************************************************************************
+* Function Name: xTaskNotifyWait
+********************************************************************************
+* Summary: Waits for a notification of the task, or for xTicksToWait ticks.
+*
+*******************************************************************************/
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+                           uint32_t *pulNotificationValue, TickType_t xTicksToWait)
+{
+    initialize();
+
+    if (!is_notification_pending)
+    {
+        notification_value &= ~ulBitsToClearOnEntry;
+
+        is_timed_out = false;
+        if (portMAX_DELAY != xTicksToWait)
+        {
+            sim_arm_event(&task_timeout_event, get_tick_time_us(xTicksToWait));
+        }
+
+        sim_block(is_task_unblocked);
+        sim_disarm_event(&task_timeout_event);
+        task_wakeup_count++;
+    }
+
+    if (NULL != pulNotificationValue)
+    {
+        *pulNotificationValue = notification_value;
+    }
+
+    if (!is_notification_pending)
+    {
+        return pdFALSE;
+    }
+
+    notification_value &= ~ulBitsToClearOnExit;
+    is_notification_pending = false;
+
+    return pdTRUE;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_rtos_get_task_wakeup_count
+********************************************************************************
+* Summary: Returns the number of times the task was blocked in xTaskNotifyWait
+* and woken up by a notification or a timeout.
+*
+*******************************************************************************/
+uint32_t sim_rtos_get_task_wakeup_count(void)
+{
+    return task_wakeup_count;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_rtos_get_task_handle
+********************************************************************************
+* Summary: Returns the handle of capsense_task, the only simulated task.
+*
+*******************************************************************************/
+TaskHandle_t sim_rtos_get_task_handle(void)
+{
+    return &capsense_task_object;
+}
+
+
+/*******************************************************************************
+* Function Name: xTaskGetIdleTaskHandle
+*******************************************************************************/
+TaskHandle_t xTaskGetIdleTaskHandle(void)
+{
+    return &idle_task_object;
+}
+
+
+/*******************************************************************************
+* Function Name: xTimerGetTimerDaemonTaskHandle
+*******************************************************************************/
+TaskHandle_t xTimerGetTimerDaemonTaskHandle(void)
+{
+    return NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: vTaskGetInfo
+********************************************************************************
+* Summary: Returns the run time of capsense_task or of the idle task in CLK_LF
+* cycles. The other fields are not maintained.
+*
+*******************************************************************************/
+void vTaskGetInfo(TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace,
+                  eTaskState eState)
+{
+    uint64_t run_time_us = 0U;
+
+    (void)xGetFreeStackSpace;
+
+    if (&capsense_task_object == xTask)
+    {
+        run_time_us = sim_get_mode_time_us(SIM_MODE_ACTIVE);
+    }
+    else if (&idle_task_object == xTask)
+    {
+        run_time_us = sim_get_mode_time_us(SIM_MODE_SLEEP) + sim_get_mode_time_us(SIM_MODE_DEEPSLEEP);
+    }
+
+    pxTaskStatus->xHandle = xTask;
+    pxTaskStatus->eCurrentState = eState;
+    pxTaskStatus->ulRunTimeCounter = (uint32_t)((run_time_us * CY_CFG_SYSCLK_CLKLF_FREQ_HZ) / 1000000U);
+}
+
+
+/*******************************************************************************
+* Function Name: xTaskNotify
+*******************************************************************************/
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction)
+{
+    (void)xTaskToNotify;
+
+    notify(ulValue, eAction);
+
+    return pdPASS;
+}
+
+
+/*******************************************************************************
+* Function Name: xTaskNotifyFromISR
+*******************************************************************************/
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                              BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void)xTaskToNotify;
+
+    notify(ulValue, eAction);
+
+    if (NULL != pxHigherPriorityTaskWoken)
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+
+    return pdPASS;
+}
+
+
+/*******************************************************************************
+* Function Name: xTimerCreate
+*******************************************************************************/
+TimerHandle_t xTimerCreate(const char *const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                           const UBaseType_t uxAutoReload, void *const pvTimerID,
+                           TimerCallbackFunction_t pxCallbackFunction)
+{
+    struct sim_timer *timer;
+
+    (void)pcTimerName;
+    (void)pvTimerID;
+
+    initialize();
+
+    if (SIM_MAX_TIMERS <= num_timers)
+    {
+        return NULL;
+    }
+
+    timer = &timers[num_timers++];
+    timer->is_active = false;
+    timer->is_auto_reload = (pdFALSE != uxAutoReload);
+    timer->period = xTimerPeriodInTicks;
+    timer->callback = pxCallbackFunction;
+
+    return timer;
+}
+
+
+/*******************************************************************************
+* Function Name: xTimerCreateStatic
+*******************************************************************************/
+TimerHandle_t xTimerCreateStatic(const char *const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                                 const UBaseType_t uxAutoReload, void *const pvTimerID,
+                                 TimerCallbackFunction_t pxCallbackFunction,
+                                 StaticTimer_t *pxTimerBuffer)
+{
+    (void)pxTimerBuffer;
+
+    return xTimerCreate(pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID,
+                        pxCallbackFunction);
+}
+
+
+/*******************************************************************************
+* Function Name: xTimerStart
+*******************************************************************************/
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+    (void)xTicksToWait;
+
+    xTimer->expiry = xTaskGetTickCount() + xTimer->period;
+    xTimer->is_active = true;
+    arm_timer_daemon();
+
+    return pdPASS;
+}
+
+
+/*******************************************************************************
+* Function Name: xTimerChangePeriod
+********************************************************************************
+* Summary: Like FreeRTOS, the timer is (re)started with the new period counted
+* from now.
+*
+*******************************************************************************/
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait)
+{
+    xTimer->period = xNewPeriod;
+
+    return xTimerStart(xTimer, xTicksToWait);
+}
+
+
+/*******************************************************************************
+* Function Name: xTimerIsTimerActive
+*******************************************************************************/
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer)
+{
+    return xTimer->is_active ? pdTRUE : pdFALSE;
+}
+
+
+/*******************************************************************************
+* Function Name: xTimerGetExpiryTime
+*******************************************************************************/
+TickType_t xTimerGetExpiryTime(TimerHandle_t xTimer)
+{
+    return xTimer->expiry;
+}
+
+
+/*******************************************************************************
+* Function Name: xTimerGetPeriod
+*******************************************************************************/
+TickType_t xTimerGetPeriod(TimerHandle_t xTimer)
+{
+    return xTimer->period;
+}
+
+
+/*******************************************************************************
+* Function Name: initialize
+********************************************************************************
+* Summary: Registers the kernel events on first use.
+*
+*******************************************************************************/
+static void initialize(void)
+{
+    if (!is_initialized)
+    {
+        sim_register_event(&task_timeout_event);
+        sim_register_event(&timer_daemon_event);
+        is_initialized = true;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: notify
+*******************************************************************************/
+static void notify(uint32_t value, eNotifyAction action)
+{
+    switch (action)
+    {
+        case eSetBits:
+            notification_value |= value;
+            break;
+
+        case eIncrement:
+            notification_value++;
+            break;
+
+        case eSetValueWithOverwrite:
+            notification_value = value;
+            break;
+
+        case eSetValueWithoutOverwrite:
+            if (!is_notification_pending)
+            {
+                notification_value = value;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    is_notification_pending = true;
+}
+
+
+/*******************************************************************************
+* Function Name: is_task_unblocked
+*******************************************************************************/
+static bool is_task_unblocked(void)
+{
+    return is_notification_pending || is_timed_out;
+}
+
+
+/*******************************************************************************
+* Function Name: is_delay_elapsed
+*******************************************************************************/
+static bool is_delay_elapsed(void)
+{
+    return is_timed_out;
+}
+
+
+/*******************************************************************************
+* Function Name: handle_task_timeout
+*******************************************************************************/
+static void handle_task_timeout(void)
+{
+    is_timed_out = true;
+}
+
+
+/*******************************************************************************
+* Function Name: handle_timer_daemon
+********************************************************************************
+* Summary: Calls the callbacks of the expired timers. Like the FreeRTOS timer
+* daemon task, an auto-reload timer that expired several times is called once
+* per expiry.
+*
+*******************************************************************************/
+static void handle_timer_daemon(void)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    for (uint32_t i = 0; i < num_timers; i++)
+    {
+        struct sim_timer *timer = &timers[i];
+
+        while (timer->is_active && ((int32_t)(now - timer->expiry) >= 0))
+        {
+            if (timer->is_auto_reload)
+            {
+                timer->expiry += timer->period;
+            }
+            else
+            {
+                timer->is_active = false;
+            }
+            timer->callback(timer);
+        }
+    }
+
+    arm_timer_daemon();
+}
+
+
+/*******************************************************************************
+* Function Name: arm_timer_daemon
+********************************************************************************
+* Summary: Schedules the timer daemon at the earliest expiry of the active
+* timers.
+*
+*******************************************************************************/
+static void arm_timer_daemon(void)
+{
+    TickType_t now = xTaskGetTickCount();
+    bool is_any_active = false;
+    TickType_t next = 0U;
+    TickType_t delay;
+
+    for (uint32_t i = 0; i < num_timers; i++)
+    {
+        if (timers[i].is_active &&
+            (!is_any_active || ((int32_t)(timers[i].expiry - next) < 0)))
+        {
+            next = timers[i].expiry;
+            is_any_active = true;
+        }
+    }
+
+    if (is_any_active)
+    {
+        /* An expiry in the past is serviced right away. */
+        delay = ((int32_t)(next - now) > 0) ? (next - now) : 0U;
+        sim_arm_event(&timer_daemon_event, get_tick_time_us(delay));
+    }
+    else
+    {
+        sim_disarm_event(&timer_daemon_event);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: get_tick_time_us
+********************************************************************************
+* Summary: Returns the simulated time of the tick interrupt that occurs ticks
+* ticks from now. The tick count itself wraps around.
+*
+*******************************************************************************/
+static uint64_t get_tick_time_us(TickType_t ticks)
+{
+    uint64_t now_us = sim_get_time_us();
+
+    return (now_us - (now_us % SIM_US_PER_TICK)) + ((uint64_t)ticks * SIM_US_PER_TICK);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,289 @@
+/******************************************************************************
+* File Name:   sim_trace.c
+*
+* Description: Scripted touch traces of the host simulation.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "sim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_TRACE_MAX_LINE              (256U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    KEYFRAME_TOUCH,
+    KEYFRAME_MOVE,
+    KEYFRAME_RELEASE,
+    KEYFRAME_END
+} keyframe_kind_t;
+
+typedef struct
+{
+    uint64_t time_us;
+    keyframe_kind_t kind;
+    uint16_t position;
+} keyframe_t;
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static keyframe_t *keyframes;
+static uint32_t num_keyframes;
+static uint64_t end_time_us;
+
+/* Index of the last keyframe returned; the simulation reads the trace
+ * forwards.
+ */
+static uint32_t current_keyframe;
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static bool add_keyframe(const keyframe_t *keyframe);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: sim_trace_load
+********************************************************************************
+* Summary: Reads the trace file. Errors are reported on stderr.
+*
+* A trace has one keyframe per line, in time order. Positions are in slider
+* units, from 0 to the resolution of the slider.
+*
+*   # comment
+*   <time_ms> touch <position>    finger down at, or jumps to, position
+*   <time_ms> move <position>     finger slides from the previous keyframe and
+*                                 arrives at position at time_ms
+*   <time_ms> release             finger lifted
+*   <time_ms> end                 end of the simulation
+*
+* Return:
+* bool: Whether the trace was read successfully.
+*
+*******************************************************************************/
+bool sim_trace_load(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[SIM_TRACE_MAX_LINE];
+    uint32_t line_number = 0U;
+    bool is_touched = false;
+    bool is_valid = true;
+
+    if (NULL == file)
+    {
+        fprintf(stderr, "%s: cannot open the trace\n", path);
+        return false;
+    }
+
+    while (is_valid && (NULL != fgets(line, sizeof(line), file)))
+    {
+        char kind[16];
+        unsigned long long time_ms;
+        unsigned int position = 0U;
+        int num_fields;
+        keyframe_t keyframe;
+
+        line_number++;
+        line[strcspn(line, "#\r\n")] = '\0';
+
+        num_fields = sscanf(line, "%llu %15s %u", &time_ms, kind, &position);
+        if (num_fields <= 0)
+        {
+            continue;
+        }
+
+        keyframe.time_us = time_ms * 1000U;
+        keyframe.position = (uint16_t)position;
+
+        if ((3 == num_fields) && (0 == strcmp(kind, "touch")))
+        {
+            keyframe.kind = KEYFRAME_TOUCH;
+            is_touched = true;
+        }
+        else if ((3 == num_fields) && (0 == strcmp(kind, "move")) && is_touched)
+        {
+            keyframe.kind = KEYFRAME_MOVE;
+        }
+        else if ((2 == num_fields) && (0 == strcmp(kind, "release")))
+        {
+            keyframe.kind = KEYFRAME_RELEASE;
+            is_touched = false;
+        }
+        else if ((2 == num_fields) && (0 == strcmp(kind, "end")))
+        {
+            keyframe.kind = KEYFRAME_END;
+        }
+        else
+        {
+            fprintf(stderr, "%s:%lu: invalid keyframe\n", path, (unsigned long)line_number);
+            is_valid = false;
+            break;
+        }
+
+        if ((0U != num_keyframes) && (keyframe.time_us < keyframes[num_keyframes - 1U].time_us))
+        {
+            fprintf(stderr, "%s:%lu: keyframes are not in time order\n", path,
+                    (unsigned long)line_number);
+            is_valid = false;
+        }
+        else if (!add_keyframe(&keyframe))
+        {
+            is_valid = false;
+        }
+        else if (KEYFRAME_END == keyframe.kind)
+        {
+            break;
+        }
+    }
+
+    fclose(file);
+
+    if (is_valid && ((0U == num_keyframes) || (KEYFRAME_END != keyframes[num_keyframes - 1U].kind)))
+    {
+        fprintf(stderr, "%s: the trace has no end keyframe\n", path);
+        is_valid = false;
+    }
+
+    if (is_valid)
+    {
+        end_time_us = keyframes[num_keyframes - 1U].time_us;
+    }
+
+    return is_valid;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_trace_get_end_time_us
+*******************************************************************************/
+uint64_t sim_trace_get_end_time_us(void)
+{
+    return end_time_us;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_trace_get_touch
+********************************************************************************
+* Summary: Returns whether the slider is touched at time_us, and the position
+* of the finger. Positions between a keyframe and a following move keyframe
+* are interpolated linearly.
+*
+*******************************************************************************/
+bool sim_trace_get_touch(uint64_t time_us, uint16_t *position)
+{
+    const keyframe_t *keyframe;
+    const keyframe_t *next;
+
+    if ((0U == num_keyframes) || (time_us < keyframes[0].time_us))
+    {
+        return false;
+    }
+
+    if (time_us < keyframes[current_keyframe].time_us)
+    {
+        current_keyframe = 0U;
+    }
+    while (((current_keyframe + 1U) < num_keyframes) &&
+           (keyframes[current_keyframe + 1U].time_us <= time_us))
+    {
+        current_keyframe++;
+    }
+
+    keyframe = &keyframes[current_keyframe];
+    if ((KEYFRAME_TOUCH != keyframe->kind) && (KEYFRAME_MOVE != keyframe->kind))
+    {
+        return false;
+    }
+
+    *position = keyframe->position;
+
+    next = ((current_keyframe + 1U) < num_keyframes) ? &keyframes[current_keyframe + 1U] : NULL;
+    if ((NULL != next) && (KEYFRAME_MOVE == next->kind))
+    {
+        int64_t distance = (int64_t)next->position - (int64_t)keyframe->position;
+
+        *position = (uint16_t)((int64_t)keyframe->position +
+                               ((distance * (int64_t)(time_us - keyframe->time_us)) /
+                                (int64_t)(next->time_us - keyframe->time_us)));
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: add_keyframe
+*******************************************************************************/
+static bool add_keyframe(const keyframe_t *keyframe)
+{
+    keyframe_t *resized = realloc(keyframes, (num_keyframes + 1U) * sizeof(keyframe_t));
+
+    if (NULL == resized)
+    {
+        fprintf(stderr, "out of memory\n");
+        return false;
+    }
+
+    keyframes = resized;
+    keyframes[num_keyframes++] = *keyframe;
+
+    return true;
+}
+
+
+/* [] END OF FILE */
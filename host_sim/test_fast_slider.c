@@ -0,0 +1,298 @@
+/******************************************************************************
+* File Name:   test_fast_slider.c
+*
+* Description: Host test of the fixed-point slider kernels of fast_slider.c against
+*              a floating-point reference: the median and IIR filter, the touch
+*              detection with hysteresis, and the centroid computed with the
+*              reciprocal table. The host build has no DSP extension, so the
+*              portable accumulation is tested instead of SMLAD.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "fast_slider.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define NUM_CENTROID_CASES              (200000U)
+#define NUM_FILTER_SAMPLES              (20000U)
+#define MAX_DIFF_COUNT                  (4000U)
+
+/* The reciprocal table has 8 significant bits, see scale_by_reciprocal. */
+#define CENTROID_RELATIVE_TOLERANCE     (1.0 / 256.0)
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static const fast_slider_config_t test_configs[] =
+{
+    { .num_sensors = 5U, .resolution = 100U,  .finger_th = 100U, .hysteresis = 10U, .noise_th = 40U },
+    { .num_sensors = 8U, .resolution = 1000U, .finger_th = 200U, .hysteresis = 20U, .noise_th = 0U  },
+    { .num_sensors = 2U, .resolution = 255U,  .finger_th = 50U,  .hysteresis = 0U,  .noise_th = 10U },
+    { .num_sensors = 6U, .resolution = 65535U, .finger_th = 100U, .hysteresis = 15U, .noise_th = 20U }
+};
+
+static uint32_t random_state = 1U;
+static uint32_t num_failures;
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: next_random
+********************************************************************************
+* Summary: Returns a pseudo-random number in [0, limit), repeatable between
+* runs.
+*
+*******************************************************************************/
+static uint32_t next_random(uint32_t limit)
+{
+    random_state = (random_state * 1103515245U) + 12345U;
+    return (random_state >> 8) % limit;
+}
+
+
+/*******************************************************************************
+* Function Name: reference_median3
+*******************************************************************************/
+static double reference_median3(double a, double b, double c)
+{
+    double values[3] = { a, b, c };
+
+    for (uint32_t i = 0; i < 2U; i++)
+    {
+        for (uint32_t j = i + 1U; j < 3U; j++)
+        {
+            if (values[j] < values[i])
+            {
+                double temp = values[i];
+                values[i] = values[j];
+                values[j] = temp;
+            }
+        }
+    }
+
+    return values[1];
+}
+
+
+/*******************************************************************************
+* Function Name: test_filter
+********************************************************************************
+* Summary: Filters a noisy random walk with fast_slider_filter and with the
+* median and IIR filter in double precision. The fixed-point output may differ
+* from the rounded reference by one count.
+*
+*******************************************************************************/
+static void test_filter(const fast_slider_config_t *config)
+{
+    fast_slider_t slider;
+    uint16_t raw[FAST_SLIDER_MAX_SENSORS];
+    double level[FAST_SLIDER_MAX_SENSORS];
+    double history[FAST_SLIDER_MAX_SENSORS][2];
+    double state[FAST_SLIDER_MAX_SENSORS];
+    double alpha = 1.0 / (double)(1U << FAST_SLIDER_IIR_SHIFT);
+    double median;
+    double error;
+
+    fast_slider_init(&slider, config);
+
+    for (uint32_t i = 0; i < config->num_sensors; i++)
+    {
+        level[i] = 1000.0 + next_random(30000U);
+    }
+
+    for (uint32_t n = 0; n < NUM_FILTER_SAMPLES; n++)
+    {
+        for (uint32_t i = 0; i < config->num_sensors; i++)
+        {
+            /* Random walk with occasional spikes for the median filter. */
+            level[i] += (double)next_random(41U) - 20.0;
+            level[i] = (level[i] < 0.0) ? 0.0 : ((level[i] > 60000.0) ? 60000.0 : level[i]);
+            raw[i] = (uint16_t)level[i];
+            if (0U == next_random(50U))
+            {
+                raw[i] = (uint16_t)next_random(65536U);
+            }
+
+            if (0U == n)
+            {
+                history[i][0] = raw[i];
+                history[i][1] = raw[i];
+                state[i] = raw[i];
+            }
+
+            median = reference_median3(history[i][0], history[i][1], raw[i]);
+            history[i][0] = history[i][1];
+            history[i][1] = raw[i];
+            state[i] += alpha * (median - state[i]);
+        }
+
+        fast_slider_filter(&slider, raw);
+
+        for (uint32_t i = 0; i < config->num_sensors; i++)
+        {
+            error = fabs((double)raw[i] - state[i]);
+            if (error > 1.0)
+            {
+                printf("FAIL filter: %lu sensors, sample %lu, sensor %lu: %u, expected %.2f\n",
+                       (unsigned long)config->num_sensors, (unsigned long)n, (unsigned long)i,
+                       raw[i], state[i]);
+                num_failures++;
+                return;
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: test_centroid
+********************************************************************************
+* Summary: Checks the touch status and the position of fast_slider_get_position
+* against the hysteresis rule and the centroid in double precision, for random
+* difference counts that peak around a random position.
+*
+*******************************************************************************/
+static void test_centroid(const fast_slider_config_t *config)
+{
+    fast_slider_t slider;
+    uint16_t diff[FAST_SLIDER_MAX_SENSORS];
+    uint16_t position = 0U;
+    bool is_reference_touched = false;
+    bool is_touched;
+    double moment;
+    double sum;
+    double reference;
+    double signal;
+    uint16_t max_diff;
+    uint32_t peak;
+    uint32_t amplitude;
+
+    fast_slider_init(&slider, config);
+
+    for (uint32_t n = 0; n < NUM_CENTROID_CASES; n++)
+    {
+        peak = next_random(config->num_sensors);
+        amplitude = next_random(MAX_DIFF_COUNT);
+        max_diff = 0U;
+        moment = 0.0;
+        sum = 0.0;
+
+        for (uint32_t i = 0; i < config->num_sensors; i++)
+        {
+            uint32_t distance = (i > peak) ? (i - peak) : (peak - i);
+
+            diff[i] = (uint16_t)((amplitude >> (2U * distance)) + next_random(30U));
+            max_diff = (diff[i] > max_diff) ? diff[i] : max_diff;
+
+            signal = (diff[i] > config->noise_th) ? (double)(diff[i] - config->noise_th) : 0.0;
+            moment += (double)i * signal;
+            sum += signal;
+        }
+
+        if (is_reference_touched)
+        {
+            is_reference_touched = ((double)max_diff + config->hysteresis >= config->finger_th);
+        }
+        else
+        {
+            is_reference_touched = ((double)max_diff > (double)config->finger_th + config->hysteresis);
+        }
+
+        is_touched = fast_slider_get_position(&slider, diff, &position);
+
+        if (!is_reference_touched || (0.0 == sum))
+        {
+            if (is_touched)
+            {
+                printf("FAIL touch: %lu sensors, case %lu: touched, expected not touched\n",
+                       (unsigned long)config->num_sensors, (unsigned long)n);
+                num_failures++;
+                return;
+            }
+            continue;
+        }
+
+        reference = (moment * config->resolution) / (sum * (config->num_sensors - 1U));
+        if (!is_touched ||
+            (fabs((double)position - reference) > ((reference * CENTROID_RELATIVE_TOLERANCE) + 1.0)))
+        {
+            printf("FAIL centroid: %lu sensors, case %lu: %s %u, expected %.2f\n",
+                   (unsigned long)config->num_sensors, (unsigned long)n,
+                   is_touched ? "position" : "not touched, position", position, reference);
+            num_failures++;
+            return;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    for (uint32_t i = 0; i < (sizeof(test_configs) / sizeof(test_configs[0])); i++)
+    {
+        test_filter(&test_configs[i]);
+        test_centroid(&test_configs[i]);
+    }
+
+    if (0U != num_failures)
+    {
+        printf("test_fast_slider: %lu failure(s)\n", (unsigned long)num_failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("PASS test_fast_slider\n");
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,226 @@
+/******************************************************************************
+* File Name:   test_scan_plan.c
+*
+* Description: Host test of the scan plan of scan_plan.c with a multi-entry
+*              plan: the widgets of every batch, as started by the task and
+*              chained by the end-of-scan interrupt and as processed by the
+*              task, over several periods of the divisors.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "scan_plan.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Batches simulated, several periods of the divisors of the test plan. */
+#define NUM_BATCHES                     (100U)
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+/* A slider in every batch, a ganged sensor in every 4th and a button in every
+ * 3rd, and a second slider in every batch. The divisor of the first entry is
+ * ignored.
+ */
+static const scan_plan_entry_t test_entries[] =
+{
+    { 10U, 2U },
+    { 20U, 4U },
+    { 30U, 3U },
+    { 40U, 1U }
+};
+
+static const scan_plan_config_t test_config =
+{
+    test_entries, sizeof(test_entries) / sizeof(test_entries[0])
+};
+
+static uint32_t num_failures;
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: get_expected_batch
+********************************************************************************
+* Summary: Returns the widgets of the batch-th batch since the plan was
+* selected, in plan order.
+*
+*******************************************************************************/
+static uint32_t get_expected_batch(uint32_t batch, uint32_t *widget_ids)
+{
+    uint32_t num_widgets = 0U;
+
+    widget_ids[num_widgets++] = 10U;
+    if (0U == (batch % 4U))
+    {
+        widget_ids[num_widgets++] = 20U;
+    }
+    if (0U == (batch % 3U))
+    {
+        widget_ids[num_widgets++] = 30U;
+    }
+    widget_ids[num_widgets++] = 40U;
+
+    return num_widgets;
+}
+
+
+/*******************************************************************************
+* Function Name: check_widgets
+*******************************************************************************/
+static void check_widgets(const char *name, uint32_t batch, const uint32_t *actual,
+                          uint32_t num_actual, const uint32_t *expected, uint32_t num_expected)
+{
+    bool is_equal = (num_actual == num_expected);
+
+    for (uint32_t i = 0; is_equal && (i < num_actual); i++)
+    {
+        is_equal = (actual[i] == expected[i]);
+    }
+
+    if (!is_equal)
+    {
+        printf("FAIL %s: batch %lu: %lu widget(s)", name, (unsigned long)batch,
+               (unsigned long)num_actual);
+        for (uint32_t i = 0; i < num_actual; i++)
+        {
+            printf(" %lu", (unsigned long)actual[i]);
+        }
+        printf(", expected %lu widget(s)", (unsigned long)num_expected);
+        for (uint32_t i = 0; i < num_expected; i++)
+        {
+            printf(" %lu", (unsigned long)expected[i]);
+        }
+        printf("\n");
+        num_failures++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: run_batches
+********************************************************************************
+* Summary: Runs num_batches batches from the batch-th one as capsense_task does:
+* the first widget is started by the task, the others are chained from the
+* end-of-scan interrupt, and the task processes the batch and ends it.
+*
+*******************************************************************************/
+static void run_batches(scan_plan_t *plan, uint32_t batch, uint32_t num_batches)
+{
+    uint32_t expected[SCAN_PLAN_MAX_ENTRIES];
+    uint32_t scanned[SCAN_PLAN_MAX_ENTRIES + 1U];
+    uint32_t processed[SCAN_PLAN_MAX_ENTRIES];
+    uint32_t num_expected;
+    uint32_t num_scanned;
+    uint32_t num_processed;
+
+    for (uint32_t end = batch + num_batches; batch < end; batch++)
+    {
+        num_expected = get_expected_batch(batch, expected);
+
+        num_scanned = 0U;
+        scanned[num_scanned++] = scan_plan_begin_batch(plan);
+        while ((num_scanned <= SCAN_PLAN_MAX_ENTRIES) &&
+               scan_plan_get_next(plan, &scanned[num_scanned]))
+        {
+            num_scanned++;
+        }
+        check_widgets("scanned", batch, scanned, num_scanned, expected, num_expected);
+
+        num_processed = scan_plan_get_batch(plan, processed);
+        check_widgets("processed", batch, processed, num_processed, expected, num_expected);
+
+        scan_plan_end_batch(plan);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    scan_plan_t plan;
+    uint32_t widget_id;
+    uint32_t widget_ids[SCAN_PLAN_MAX_ENTRIES];
+    uint32_t num_widgets;
+
+    scan_plan_init(&plan, &test_config);
+
+    /* Before the task starts a batch, e.g. while the scans are started from
+     * the LPTimer interrupt, only the first entry is scanned and processed.
+     */
+    num_widgets = scan_plan_get_batch(&plan, widget_ids);
+    if (scan_plan_get_next(&plan, &widget_id) || (1U != num_widgets) || (10U != widget_ids[0]))
+    {
+        printf("FAIL before the first batch: %lu widget(s) in the batch\n",
+               (unsigned long)num_widgets);
+        num_failures++;
+    }
+
+    run_batches(&plan, 0U, NUM_BATCHES);
+
+    /* Selecting the plan again, as at a tier transition, restarts the
+     * divisors: every entry is due in the next batch.
+     */
+    scan_plan_init(&plan, &test_config);
+    run_batches(&plan, 0U, 13U);
+
+    if (0U != num_failures)
+    {
+        printf("test_scan_plan: %lu failure(s)\n", (unsigned long)num_failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("PASS test_scan_plan\n");
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
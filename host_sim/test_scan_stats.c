@@ -0,0 +1,250 @@
+/******************************************************************************
+* File Name:   test_scan_stats.c
+*
+* Description: Host test of the scan latency statistics of scan_stats.c with
+*              a known sequence of scans: the histogram bucket of each
+*              trigger-to-report latency, including the bucket edges, the
+*              last bucket and a wrap-around of the cycle counter, and the
+*              ring buffer of the most recent latencies before and after it
+*              wraps around.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+#include "scan_stats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Scans of the ring buffer test, more than fit in the ring buffer. */
+#define NUM_RING_SCANS                  (SCAN_STATS_RING_SIZE + 8U)
+
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef struct
+{
+    uint32_t start_cycles;      /* Cycle counter at the trigger */
+    uint32_t latency_us;        /* Trigger to report */
+    uint32_t bucket;            /* Expected histogram bucket */
+} test_scan_t;
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+/* Stand-ins of sim_hal.c. A clock of 1 MHz makes a cycle a microsecond. */
+uint32_t SystemCoreClock = 1000000UL;
+DWT_Type sim_dwt;
+CoreDebug_Type sim_core_debug;
+
+static uint32_t test_cycles;
+
+/* Scans of LinearSlider0. */
+static const test_scan_t test_scans[] =
+{
+    { 1000U, 0U, 0U },
+    { 2000U, SCAN_STATS_HIST_BUCKET_US - 1U, 0U },
+    { 3000U, SCAN_STATS_HIST_BUCKET_US, 1U },
+    { 4000U, (SCAN_STATS_HIST_BUCKETS * SCAN_STATS_HIST_BUCKET_US) - 1U, SCAN_STATS_HIST_BUCKETS - 1U },
+    /* Larger values are counted in the last bucket. */
+    { 9000U, SCAN_STATS_HIST_BUCKETS * SCAN_STATS_HIST_BUCKET_US, SCAN_STATS_HIST_BUCKETS - 1U },
+    { 20000U, 1000000U, SCAN_STATS_HIST_BUCKETS - 1U },
+    /* The cycle counter wraps around during the scan. */
+    { UINT32_MAX - 100U, 700U, 2U }
+};
+
+static uint32_t num_failures;
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: sim_get_cycles
+*******************************************************************************/
+uint32_t sim_get_cycles(void)
+{
+    return test_cycles;
+}
+
+
+/*******************************************************************************
+* Function Name: run_scan
+********************************************************************************
+* Summary: Marks the instrumentation points of a scan of widget_id that is
+* reported latency_us after the trigger at start_cycles.
+*
+*******************************************************************************/
+static void run_scan(uint32_t widget_id, uint32_t start_cycles, uint32_t latency_us)
+{
+    test_cycles = start_cycles;
+    scan_stats_mark(SCAN_STATS_TRIGGER);
+    test_cycles += latency_us / 4U;
+    scan_stats_mark(SCAN_STATS_SCAN_START);
+    test_cycles += latency_us / 2U;
+    scan_stats_mark(SCAN_STATS_SCAN_END);
+    test_cycles = start_cycles + latency_us;
+    scan_stats_complete(widget_id);
+}
+
+
+/*******************************************************************************
+* Function Name: check_recent
+********************************************************************************
+* Summary: Checks the ring buffer against the latencies and the widget of the
+* scans, oldest first.
+*
+*******************************************************************************/
+static void check_recent(const char *name, const uint32_t *expected_latencies,
+                         uint32_t expected_widget_id, uint32_t num_expected)
+{
+    uint32_t latencies[SCAN_STATS_RING_SIZE];
+    uint8_t widget_ids[SCAN_STATS_RING_SIZE];
+    uint32_t num_latencies = scan_stats_get_recent(latencies, widget_ids);
+
+    if (num_latencies != num_expected)
+    {
+        printf("FAIL %s: %lu recent latencies, expected %lu\n", name,
+               (unsigned long)num_latencies, (unsigned long)num_expected);
+        num_failures++;
+        return;
+    }
+
+    for (uint32_t i = 0; i < num_latencies; i++)
+    {
+        if ((latencies[i] != expected_latencies[i]) || (widget_ids[i] != expected_widget_id))
+        {
+            printf("FAIL %s: recent latency %lu is %u:%lu, expected %lu:%lu\n", name,
+                   (unsigned long)i, widget_ids[i], (unsigned long)latencies[i],
+                   (unsigned long)expected_widget_id, (unsigned long)expected_latencies[i]);
+            num_failures++;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    const uint32_t num_scans = sizeof(test_scans) / sizeof(test_scans[0]);
+    const scan_stats_widget_t *stats;
+    uint32_t expected_histogram[SCAN_STATS_HIST_BUCKETS] = { 0U };
+    uint32_t expected_latencies[NUM_RING_SCANS] = { 0U };
+
+    scan_stats_init();
+    check_recent("after init", expected_latencies, 0U, 0U);
+
+    for (uint32_t i = 0; i < num_scans; i++)
+    {
+        run_scan(CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, test_scans[i].start_cycles,
+                 test_scans[i].latency_us);
+        expected_histogram[test_scans[i].bucket]++;
+        expected_latencies[i] = test_scans[i].latency_us;
+    }
+
+    stats = scan_stats_get(CY_CAPSENSE_LINEARSLIDER0_WDGT_ID);
+    for (uint32_t i = 0; i < SCAN_STATS_HIST_BUCKETS; i++)
+    {
+        if (stats->histogram[i] != expected_histogram[i])
+        {
+            printf("FAIL histogram bucket %lu: %lu, expected %lu\n", (unsigned long)i,
+                   (unsigned long)stats->histogram[i], (unsigned long)expected_histogram[i]);
+            num_failures++;
+        }
+    }
+
+    if ((stats->interval[SCAN_STATS_NUM_POINTS - 1U].count != num_scans) ||
+        (stats->interval[SCAN_STATS_NUM_POINTS - 1U].min != 0U) ||
+        (stats->interval[SCAN_STATS_NUM_POINTS - 1U].max != 1000000U))
+    {
+        printf("FAIL trigger -> processed: count %lu min %lu max %lu\n",
+               (unsigned long)stats->interval[SCAN_STATS_NUM_POINTS - 1U].count,
+               (unsigned long)stats->interval[SCAN_STATS_NUM_POINTS - 1U].min,
+               (unsigned long)stats->interval[SCAN_STATS_NUM_POINTS - 1U].max);
+        num_failures++;
+    }
+
+    /* A zero latency is kept like any other. */
+    check_recent("before the ring buffer wraps around", expected_latencies,
+                 CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, num_scans);
+
+    /* An invalid widget is not accounted. */
+    run_scan(CY_CAPSENSE_WIDGET_COUNT, 0U, 100U);
+    if (NULL != scan_stats_get(CY_CAPSENSE_WIDGET_COUNT))
+    {
+        printf("FAIL statistics of an invalid widget\n");
+        num_failures++;
+    }
+    check_recent("after an invalid widget", expected_latencies,
+                 CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, num_scans);
+
+    /* Only the most recent scans are kept. */
+    for (uint32_t i = 0; i < NUM_RING_SCANS; i++)
+    {
+        expected_latencies[i] = 10U * (i + 1U);
+        run_scan(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID, 1000U * i, expected_latencies[i]);
+    }
+    check_recent("after the ring buffer wraps around",
+                 &expected_latencies[NUM_RING_SCANS - SCAN_STATS_RING_SIZE],
+                 CY_CAPSENSE_GANGEDSENSOR_WDGT_ID, SCAN_STATS_RING_SIZE);
+
+    if (0U != num_failures)
+    {
+        printf("test_scan_stats: %lu failure(s)\n", (unsigned long)num_failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("PASS test_scan_stats\n");
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
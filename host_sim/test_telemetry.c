@@ -0,0 +1,213 @@
+/******************************************************************************
+* File Name:   test_telemetry.c
+*
+* Description: Host side of the round-trip test of the binary telemetry of
+*              telemetry.c: encodes every event type, including negative
+*              zigzag fields and multi-byte varints, with a corrupted frame
+*              and the sync frames that re-anchor the time after it. Writes
+*              the stream and the fields that tools/telemetry_decode.py --raw
+*              must decode from it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "telemetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Unknown to the decoder, which must still decode the fields. */
+#define TEST_UNKNOWN_EVENT_TYPE         (12U)
+
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef struct
+{
+    touch_event_t event;
+    bool is_sync_requested;     /* telemetry_request_sync before the event */
+    bool is_sync_expected;      /* A sync frame must precede the frame */
+    bool is_corrupted;          /* The CRC of the frame is corrupted */
+} test_step_t;
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+/* Fields of touch_event_t: type, arg, value, data, timestamp_ms. */
+static const test_step_t test_steps[] =
+{
+    /* The first frame is preceded by a sync frame. All the fields are zero. */
+    { { TOUCH_EVENT_SLIDER_POSITION, 0U, 0U, 0, 5U }, false, true, false },
+    { { TOUCH_EVENT_SCAN_RATE, 2U, 20U, 0, 25U }, false, false, false },
+    { { TOUCH_EVENT_GESTURE, 4U, 300U, -1234, 40U }, false, false, false },
+    { { TOUCH_EVENT_AVERAGE_CURRENT, 0U, 0U, 22203, 45U }, false, false, false },
+    /* Two-byte time delta. */
+    { { TOUCH_EVENT_TRIGGER_LATENCY, 0U, 0U, 150, 300U }, false, false, false },
+    { { TOUCH_EVENT_TOUCH_STATE, 1U, 1U, 0, 301U }, false, false, false },
+    { { TOUCH_EVENT_SENSOR_COUNTS, 0x12U, 65535U, INT32_MIN, 302U }, false, false, false },
+    { { TOUCH_EVENT_STACK_HIGH_WATER, 2U, 0U, 1024, 302U }, false, false, false },
+    { { TOUCH_EVENT_RUN_TIME, 3U, 999U, INT32_MAX, 310U }, false, false, false },
+    /* Events have been dropped. */
+    { { TOUCH_EVENT_DROPPED, 0U, 0U, 3, 1000U }, true, true, false },
+    /* The decoder loses the time at a corrupted frame... */
+    { { TOUCH_EVENT_SLIDER_POSITION, 0U, 50U, 0, 1010U }, false, false, true },
+    { { TOUCH_EVENT_SLIDER_POSITION, 0U, 60U, 0, 1020U }, false, false, false },
+    /* ...until the periodic sync frame. */
+    { { TOUCH_EVENT_SLIDER_POSITION, 0U, 70U, 0, 1000U + TELEMETRY_SYNC_INTERVAL_MS }, false, true, false },
+    { { TEST_UNKNOWN_EVENT_TYPE, 2U, 1U, -1, 11001U }, false, false, false },
+    /* Five-byte timestamp in the sync frame, then the timestamp wraps around. */
+    { { TOUCH_EVENT_SCAN_RATE, 0U, 1000U, 1, 0xFFFFFFF0U }, false, true, false },
+    { { TOUCH_EVENT_SLIDER_POSITION, 0U, 80U, 0, 5U }, false, false, false }
+};
+
+static uint32_t num_failures;
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Encodes the test steps and checks where the sync frames are. If the
+* paths are given, writes the stream to the first one and the expected output
+* of tools/telemetry_decode.py --raw to the second one.
+*
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    telemetry_encoder_t encoder;
+    uint8_t output[TELEMETRY_MAX_OUTPUT_SIZE];
+    FILE *stream_file = NULL;
+    FILE *expected_file = NULL;
+    bool is_anchored = false;
+
+    if (argc == 3)
+    {
+        stream_file = fopen(argv[1], "wb");
+        expected_file = fopen(argv[2], "w");
+        if ((NULL == stream_file) || (NULL == expected_file))
+        {
+            printf("FAIL cannot create %s or %s\n", argv[1], argv[2]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    telemetry_init(&encoder);
+
+    for (uint32_t i = 0U; i < sizeof(test_steps) / sizeof(test_steps[0]); i++)
+    {
+        const test_step_t *step = &test_steps[i];
+        const touch_event_t *event = &step->event;
+        uint32_t length;
+        bool is_sync = false;
+
+        if (step->is_sync_requested)
+        {
+            telemetry_request_sync(&encoder);
+        }
+
+        length = telemetry_encode(&encoder, event, output);
+
+        if ((length > TELEMETRY_SYNC_FRAME_SIZE) && (TELEMETRY_SYNC_BYTE == output[0]) &&
+            (TELEMETRY_SYNC_TYPE == output[1]))
+        {
+            is_sync = true;
+        }
+        if (is_sync != step->is_sync_expected)
+        {
+            printf("FAIL step %lu: sync frame %s\n", (unsigned long)i,
+                   is_sync ? "not expected" : "missing");
+            num_failures++;
+        }
+
+        if (step->is_corrupted)
+        {
+            output[length - 1U] ^= 0xFFU;
+            is_anchored = false;
+        }
+        else
+        {
+            is_anchored = is_anchored || is_sync;
+            if (NULL != expected_file)
+            {
+                if (is_anchored)
+                {
+                    fprintf(expected_file, "%lu", (unsigned long)event->timestamp_ms);
+                }
+                else
+                {
+                    fprintf(expected_file, "?");
+                }
+                fprintf(expected_file, " %u %u %u %ld\n", event->type, event->value,
+                        event->arg, (long)event->data);
+            }
+        }
+
+        if (NULL != stream_file)
+        {
+            fwrite(output, 1U, length, stream_file);
+        }
+    }
+
+    if (NULL != stream_file)
+    {
+        fclose(stream_file);
+        fclose(expected_file);
+    }
+
+    if (0U != num_failures)
+    {
+        printf("test_telemetry: %lu failure(s)\n", (unsigned long)num_failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("PASS test_telemetry\n");
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
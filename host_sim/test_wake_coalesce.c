@@ -0,0 +1,185 @@
+/******************************************************************************
+* File Name:   test_wake_coalesce.c
+*
+* Description: Host test of the wake-up coalescing of wake_coalesce.c with an
+*              LPTimer anchor whose period is not a whole number of RTOS ticks:
+*              an aligned wake-up must be the first tick at or after a scan
+*              wake-up, however many periods the slack spans.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "wake_coalesce.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define NUM_CASES                       (100000U)
+
+/* LPTimer clock of the anchor, and the 20 ms scan period in its ticks: 655.36
+ * ticks, truncated by the timer to 655, or 19.99 RTOS ticks.
+ */
+#define ANCHOR_FREQ_HZ                  (32768U)
+#define ANCHOR_PERIOD                   (655U)
+
+#define MAX_DELAY_TICKS                 (5000U)
+#define MAX_SLACK_TICKS                 (2000U)
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static uint32_t anchor_time_to_next;
+static uint32_t random_state = 1U;
+static uint32_t num_failures;
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: next_random
+********************************************************************************
+* Summary: Returns a pseudo-random number in [0, limit), repeatable between
+* runs.
+*
+*******************************************************************************/
+static uint32_t next_random(uint32_t limit)
+{
+    random_state = (random_state * 1103515245U) + 12345U;
+    return (random_state >> 8) % limit;
+}
+
+
+/*******************************************************************************
+* Function Name: get_anchor
+********************************************************************************
+* Summary: Anchor standing in for the LPTimer scan trigger.
+*
+*******************************************************************************/
+static bool get_anchor(uint32_t *time_to_next, uint32_t *period)
+{
+    *time_to_next = anchor_time_to_next;
+    *period = ANCHOR_PERIOD;
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: test_case
+********************************************************************************
+* Summary: Checks one delay against the scan wake-ups computed in LPTimer ticks:
+* an aligned delay is the first RTOS tick at or after a scan wake-up within the
+* slack, and the delay is unchanged if there is no scan wake-up within it.
+*
+*******************************************************************************/
+static void test_case(TickType_t delay, TickType_t slack)
+{
+    uint32_t aligned_count = wake_coalesce_get_aligned_count();
+    TickType_t actual = wake_coalesce_get_delay(delay, slack);
+    uint64_t delay_units = ((uint64_t)delay * ANCHOR_FREQ_HZ) / configTICK_RATE_HZ;
+    uint64_t limit_units = ((uint64_t)(delay + slack) * ANCHOR_FREQ_HZ) / configTICK_RATE_HZ;
+    uint64_t wakeup = anchor_time_to_next;
+    TickType_t expected = delay;
+
+    while (wakeup < delay_units)
+    {
+        wakeup += ANCHOR_PERIOD;
+    }
+
+    if ((wakeup != delay_units) && (wakeup <= limit_units))
+    {
+        expected = (TickType_t)(((wakeup * configTICK_RATE_HZ) + ANCHOR_FREQ_HZ - 1U) /
+                                ANCHOR_FREQ_HZ);
+    }
+
+    if ((actual != expected) ||
+        ((expected != delay) != (aligned_count != wake_coalesce_get_aligned_count())))
+    {
+        printf("FAIL next scan in %lu LPTimer ticks, delay %lu, slack %lu: %lu, expected %lu\n",
+               (unsigned long)anchor_time_to_next, (unsigned long)delay, (unsigned long)slack,
+               (unsigned long)actual, (unsigned long)expected);
+        num_failures++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    wake_coalesce_set_anchor(get_anchor, ANCHOR_FREQ_HZ);
+
+    /* 1 s with up to 200 ms of slack lands on the 50th scan after the first
+     * one, 32850 LPTimer ticks or 1003 ticks from now. Truncating the period
+     * to 19 ticks would have put it at 1011 ticks, after the scan.
+     */
+    anchor_time_to_next = 100U;
+    if (1003U != wake_coalesce_get_delay(1000U, 200U))
+    {
+        printf("FAIL 1 s with 200 ms of slack: %lu, expected 1003\n",
+               (unsigned long)wake_coalesce_get_delay(1000U, 200U));
+        num_failures++;
+    }
+
+    for (uint32_t i = 0; i < NUM_CASES; i++)
+    {
+        anchor_time_to_next = next_random(ANCHOR_PERIOD + 1U);
+        test_case((TickType_t)next_random(MAX_DELAY_TICKS),
+                  (TickType_t)next_random(MAX_SLACK_TICKS));
+    }
+
+    if (0U != num_failures)
+    {
+        printf("test_wake_coalesce: %lu failure(s)\n", (unsigned long)num_failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("PASS test_wake_coalesce\n");
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
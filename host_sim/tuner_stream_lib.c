@@ -0,0 +1,80 @@
+/******************************************************************************
+* File Name:   tuner_stream_lib.c
+*
+* Description: Shared library of the tuner stream encoder for the host tools.
+*              Built from source/tuner_stream.c by make -C host_sim lib and loaded
+*              by tools/ezi2c_loopback.py, so that the demo device streams the
+*              frames of the firmware encoder. Exports the sizes of the encoder
+*              structures, which the tools allocate.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "tuner_stream.h"
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tuner_stream_lib_get_stream_size
+********************************************************************************
+* Summary: Returns the size of tuner_stream_t in bytes.
+*
+*******************************************************************************/
+uint32_t tuner_stream_lib_get_stream_size(void)
+{
+    return (uint32_t)sizeof(tuner_stream_t);
+}
+
+
+/*******************************************************************************
+* Function Name: tuner_stream_lib_get_window_size
+********************************************************************************
+* Summary: Returns the size of tuner_stream_window_t in bytes.
+*
+*******************************************************************************/
+uint32_t tuner_stream_lib_get_window_size(void)
+{
+    return (uint32_t)sizeof(tuner_stream_window_t);
+}
+
+
+/* [] END OF FILE */
@@ -48,6 +48,19 @@
 #include "cy_pdl.h"
 
 #include "low_power_config.h"
+#include "sram_retention.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* SRAM0_POWER_DOWN_MASK, the SRAM0 macros powered off in deep sleep, is
+ * generated from the linker script into sram_retention_mask.h at pre-build.
+ * To override it, define it above the include; the post-build step
+ * tools/sram_retention.py fails the build if the mask in effect covers a macro
+ * that holds the CM4 RAM of the linked image.
+ */
+#include "sram_retention_mask.h"
 
 
 /*******************************************************************************
@@ -67,10 +80,7 @@ void retain_sram_selectively(void)
      * section for CM0+ CPU and the last 2KB in block 9 is reserved for system
      * call, which if disabled will result in unexpected behavior.
      */
-    for (uint32_t i = 1; i < 8; i++)
-    {
-        CPUSS->RAM0_PWR_MACRO_CTL[i] = 0x05FA0000;
-    }
+    (void)sram_retention_power_down(SRAM0_POWER_DOWN_MASK);
 }
 
 
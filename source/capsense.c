@@ -50,34 +50,54 @@
 #include "cy_pdl.h"
 
 #include "capsense.h"
+#include "scan_policy.h"
+#include "scan_plan.h"
+#include "scan_stats.h"
+#include "touch_event.h"
+#include "wake_coalesce.h"
+#if (defined(FAST_SLIDER_ENABLE))
+#include "fast_slider.h"
+#endif /* FAST_SLIDER_ENABLE */
+#if (defined(UART_TX_DMA_ENABLE))
+#include "uart_tx.h"
+#endif /* UART_TX_DMA_ENABLE */
+#if (defined(GESTURE_ENABLE))
+#include "gesture.h"
+#endif /* GESTURE_ENABLE */
+#if (defined(RESIDENCY_STATS_ENABLE))
+#include "residency.h"
+#endif /* RESIDENCY_STATS_ENABLE */
+#if (defined(SCAN_TRIGGER_LPTIMER) || defined(TOUCH_PREDICTOR_ENABLE))
+#include "lp_timer.h"
+#endif /* SCAN_TRIGGER_LPTIMER || TOUCH_PREDICTOR_ENABLE */
+#if (defined(TOUCH_PREDICTOR_ENABLE))
+#include "touch_predictor.h"
+#endif /* TOUCH_PREDICTOR_ENABLE */
+#if (defined(ENERGY_MODEL_ENABLE))
+#include "energy_model.h"
+#endif /* ENERGY_MODEL_ENABLE */
+#if (defined(TUNER_SNAPSHOT_ENABLE))
+#include "tuner_snapshot.h"
+#endif /* TUNER_SNAPSHOT_ENABLE */
+#if (defined(TUNER_STREAM_ENABLE))
+#include "tuner_stream.h"
+#endif /* TUNER_STREAM_ENABLE */
+#if (defined(RUNTIME_STATS_ENABLE))
+#include "runtime_stats.h"
+#endif /* RUNTIME_STATS_ENABLE */
 
 #include "FreeRTOS.h"
 #include "timers.h"
 
+#if (defined(SCAN_LATENCY_STATS_ENABLE) || defined(RESIDENCY_STATS_ENABLE) || defined(TELEMETRY_ENABLE))
+#include "cy_retarget_io.h"
 #include <stdio.h>
+#endif /* SCAN_LATENCY_STATS_ENABLE || RESIDENCY_STATS_ENABLE || TELEMETRY_ENABLE */
 
 
 /*******************************************************************************
 * Macros
 *******************************************************************************/
-/* In this example, the CapSense scans are performed at different rates
- * depending on touch detection. The scans performed every 
- * CAPSENSE_FAST_SCAN_INTERVAL_MS are fast scans and the scans performed at 
- * CAPSENSE_SLOW_SCAN_INTERVAL_MS are slow scans.
- */
-#define CAPSENSE_FAST_SCAN_INTERVAL_MS       (20U)
-#define CAPSENSE_SLOW_SCAN_INTERVAL_MS       (200U)
-
-/* Maximum number of fast scans after which the scans are initiated every
- * CAPSENSE_SLOW_SCAN_INTERVAL_MS.
- */
-#define MAX_CAPSENSE_FAST_SCAN_COUNT         (100U)
-
-/* This is the value of the variable capsense_fast_scan_count at the beginning
- * of every fast scan cycle.
- */
-#define RESET_CAPSENSE_FAST_SCAN_COUNT       (1U)
-
 /* These macros define the operations that are performed by the CPU in the
  * example. They are,
  * INITIATE_SCAN: In this state, the device initiates a CapSense scan if the
@@ -110,18 +130,225 @@
 #define WAIT_IN_DEEP_SLEEP                   (4U)
 #define UNUSED_STATE                         (5U)
 
+/* Characters received on the debug UART that print the statistics. */
+#define UART_CMD_PRINT_SCAN_STATS            ('s')
+#define UART_CMD_PRINT_RESIDENCY             ('r')
+#define UART_CMD_SEND_COUNTS                 ('c')
+
+#if (defined(TELEMETRY_ENABLE))
+/* The raw and difference counts of a sensor are posted when its raw count has
+ * moved by more than the noise threshold of the widget since it was last
+ * posted. All sensors of a widget are posted when its touch state changes,
+ * every TELEMETRY_COUNTS_TOUCHED_DECIMATION scans while it is touched, and at
+ * the next scan after UART_CMD_SEND_COUNTS has been received. The event
+ * argument holds the sensor index in 4 bits.
+ */
+#define TELEMETRY_COUNTS_TOUCHED_DECIMATION  (4U)
+#define TELEMETRY_COUNTS_MAX_SENSORS         (16U)
+#endif /* TELEMETRY_ENABLE */
+
+#if (defined(CAPSENSE_ISR_SCAN_ENABLE))
+#if (!defined(SCAN_TRIGGER_LPTIMER) || defined(CAPSENSE_TUNER_ENABLE))
+#error "CAPSENSE_ISR_SCAN_ENABLE requires SCAN_TRIGGER_LPTIMER and is not supported with CAPSENSE_TUNER_ENABLE."
+#endif
+
+/* In the Ganged Sensor tiers, the scans are started from the LPTimer interrupt
+ * and the end-of-scan callback wakes capsense_task only if the raw count
+ * exceeds the baseline by CAPSENSE_ISR_WAKE_THRESHOLD_PERCENT of the finger
+ * threshold. The task is also woken after CAPSENSE_ISR_MAX_SKIPPED_SCANS
+ * consecutive scans so that the baseline keeps tracking the environment.
+ */
+#define CAPSENSE_ISR_WAKE_THRESHOLD_PERCENT  (50U)
+#define CAPSENSE_ISR_MAX_SKIPPED_SCANS       (10U)
+#endif /* CAPSENSE_ISR_SCAN_ENABLE */
+
+#if (defined(FAST_SLIDER_ENABLE) && defined(CAPSENSE_TUNER_ENABLE))
+#error "FAST_SLIDER_ENABLE is not supported with CAPSENSE_TUNER_ENABLE."
+#endif
+
+#if (defined(TUNER_STREAM_ENABLE) && !defined(CAPSENSE_TUNER_ENABLE))
+#error "TUNER_STREAM_ENABLE requires CAPSENSE_TUNER_ENABLE."
+#endif
+
+#if (defined(TUNER_SNAPSHOT_ENABLE) && defined(CAPSENSE_TUNER_ENABLE))
+#error "TUNER_SNAPSHOT_ENABLE and CAPSENSE_TUNER_ENABLE both use the EZI2C slave."
+#endif
+
+#if (defined(GANGED_FAST_PATH_ENABLE))
+#if (defined(CAPSENSE_TUNER_ENABLE))
+#error "GANGED_FAST_PATH_ENABLE is not supported with CAPSENSE_TUNER_ENABLE."
+#endif
+
+/* The Ganged Sensor is fully processed only while the largest raw count minus
+ * baseline is inside the proximity band. The band is entered when the signal
+ * reaches GANGED_FAST_PATH_ENTER_PERCENT of the finger threshold and left when
+ * it drops below GANGED_FAST_PATH_EXIT_PERCENT. Outside of the band, the widget
+ * is processed only every GANGED_FAST_PATH_MAX_SKIPPED_SCANS scans so that the
+ * baseline keeps tracking the environment.
+ */
+#define GANGED_FAST_PATH_ENTER_PERCENT       (40U)
+#define GANGED_FAST_PATH_EXIT_PERCENT        (20U)
+#define GANGED_FAST_PATH_MAX_SKIPPED_SCANS   (10U)
+#endif /* GANGED_FAST_PATH_ENABLE */
+
 
 /*******************************************************************************
  * Global variables
  ******************************************************************************/
 #if (defined(CAPSENSE_TUNER_ENABLE))
-static cy_stc_scb_ezi2c_context_t ezi2c_context;
 static cyhal_ezi2c_t sEzI2C;
 static cyhal_ezi2c_slave_cfg_t sEzI2C_sub_cfg;
 static cyhal_ezi2c_cfg_t sEzI2C_cfg;
+
+/* The host reads complete frames of cy_capsense_tuner from the front buffer
+ * while the next frame is copied to the back buffer. tuner_shadow holds the
+ * front buffer as published, so that the bytes written by the host can be
+ * detected and applied to cy_capsense_tuner. The scan counter of the common
+ * context identifies the frame.
+ */
+static cy_stc_capsense_tuner_t tuner_buffer[2];
+static cy_stc_capsense_tuner_t tuner_shadow;
+static uint32_t tuner_front;
+
+#if (defined(TUNER_STREAM_ENABLE))
+/* Delta-encoded counts of the recent frames, served on the second address. */
+static tuner_stream_t tuner_stream;
+static tuner_stream_window_t tuner_stream_window;
+#endif /* TUNER_STREAM_ENABLE */
 #endif /*CAPSENSE_TUNER_ENABLE*/
 
+#if (!defined(SCAN_TRIGGER_LPTIMER))
 static TimerHandle_t  scan_timer_handle;
+#if (defined(STATIC_ALLOCATION_ONLY))
+static StaticTimer_t scan_timer_buffer;
+#endif /* STATIC_ALLOCATION_ONLY */
+#endif /* SCAN_TRIGGER_LPTIMER */
+
+/* Scan-rate tiers ordered from the fastest to the slowest. The slider is
+ * scanned while the user is interacting with it. Once the device has been idle
+ * for a while, only the Ganged Sensor widget is scanned to detect a touch
+ * anywhere on the slider, which brings the policy back to the fastest tier.
+ */
+static const scan_policy_tier_t scan_policy_tiers[] =
+{
+    { CAPSENSE_FAST_SCAN_INTERVAL_MS,      CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, MAX_CAPSENSE_FAST_SCAN_COUNT   },
+    { CAPSENSE_MEDIUM_SCAN_INTERVAL_MS,    CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, MAX_CAPSENSE_MEDIUM_SCAN_COUNT },
+    { CAPSENSE_SLOW_SCAN_INTERVAL_MS,      CY_CAPSENSE_GANGEDSENSOR_WDGT_ID,  MAX_CAPSENSE_SLOW_SCAN_COUNT   },
+    { CAPSENSE_DEEP_IDLE_SCAN_INTERVAL_MS, CY_CAPSENSE_GANGEDSENSOR_WDGT_ID,  0U                             }
+};
+
+/* Scan-rate policy state. */
+static scan_policy_t scan_policy;
+
+/* Scan plans of the tiers, indexed by tier. A batch of scans is performed at
+ * every timer period of the tier, and all the widgets of the batch are scanned
+ * in a single wake-up of capsense_task. The first entry of every plan is the
+ * widget of the tier and is scanned in every batch. Further entries are
+ * scanned every divisor-th batch, e.g. { CY_CAPSENSE_BUTTON0_WDGT_ID, 4U }
+ * scans a button in every 4th batch of the slider tiers. The plans have a
+ * single entry on purpose: the Ganged Sensor is the slider sensors connected
+ * together, so neither widget adds information in the tiers of the other.
+ */
+static const scan_plan_entry_t slider_scan_plan[] =
+{
+    { CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, 1U }
+};
+
+static const scan_plan_entry_t ganged_scan_plan[] =
+{
+    { CY_CAPSENSE_GANGEDSENSOR_WDGT_ID,  1U }
+};
+
+static const scan_plan_config_t scan_plan_tiers[] =
+{
+    { slider_scan_plan, sizeof(slider_scan_plan) / sizeof(slider_scan_plan[0]) },
+    { slider_scan_plan, sizeof(slider_scan_plan) / sizeof(slider_scan_plan[0]) },
+    { ganged_scan_plan, sizeof(ganged_scan_plan) / sizeof(ganged_scan_plan[0]) },
+    { ganged_scan_plan, sizeof(ganged_scan_plan) / sizeof(ganged_scan_plan[0]) }
+};
+
+/* Scan plan state of the current tier. */
+static scan_plan_t scan_plan;
+
+#if (!defined(CAPSENSE_TUNER_ENABLE))
+/* Widget last set up with Cy_CapSense_SetupWidget. */
+static volatile uint32_t setup_widget_id;
+#endif /* CAPSENSE_TUNER_ENABLE */
+
+#if (defined(FAST_SLIDER_ENABLE))
+/* Fixed-point filter and centroid state of LinearSlider0. */
+static fast_slider_t fast_slider;
+#endif /* FAST_SLIDER_ENABLE */
+
+#if (defined(GESTURE_ENABLE))
+/* Gesture recognizer fed with the LinearSlider0 position stream. */
+static gesture_t slider_gesture;
+#endif /* GESTURE_ENABLE */
+
+#if (defined(TELEMETRY_ENABLE))
+/* Raw counts as last posted, touched scans since all sensors were last posted,
+ * and widgets whose counts have been requested with UART_CMD_SEND_COUNTS.
+ */
+static uint16_t telemetry_posted_raw[CY_CAPSENSE_TOTAL_WIDGET_COUNT][TELEMETRY_COUNTS_MAX_SENSORS];
+static uint32_t telemetry_touched_scans[CY_CAPSENSE_TOTAL_WIDGET_COUNT];
+static bool telemetry_is_counts_requested[CY_CAPSENSE_TOTAL_WIDGET_COUNT];
+#endif /* TELEMETRY_ENABLE */
+
+#if (defined(RESIDENCY_STATS_ENABLE))
+/* Names of the FSM states used when printing the residency, indexed by state. */
+static const char *const residency_state_names[] =
+{
+    [INITIATE_SCAN]         = "INITIATE_SCAN",
+    [WAIT_IN_SLEEP]         = "WAIT_IN_SLEEP",
+    [PROCESS_TOUCH]         = "PROCESS_TOUCH",
+    [WAIT_IN_DEEP_SLEEP]    = "WAIT_IN_DEEP_SLEEP"
+};
+#endif /* RESIDENCY_STATS_ENABLE */
+
+#if (defined(CAPSENSE_ISR_SCAN_ENABLE))
+/* is_isr_scan_enabled: set by capsense_task when the scans of the current tier
+ * can be handled in the ISR.
+ * is_isr_scan_active: the ongoing scan was started from the LPTimer interrupt.
+ * isr_skipped_scan_count: scans completed in the ISR without waking the task.
+ */
+static volatile bool is_isr_scan_enabled = false;
+static volatile bool is_isr_scan_active = false;
+static volatile uint32_t isr_skipped_scan_count = 0;
+#endif /* CAPSENSE_ISR_SCAN_ENABLE */
+
+#if (defined(TOUCH_PREDICTOR_ENABLE))
+/* Usage history used to pre-warm fast scan and to shorten the idle time-outs
+ * during usually quiet periods.
+ */
+static touch_predictor_t touch_predictor;
+#endif /* TOUCH_PREDICTOR_ENABLE */
+
+#if (defined(ENERGY_MODEL_ENABLE))
+/* Per-widget coefficients of the energy model, indexed by widget ID, for the
+ * processing path of the build.
+ */
+static const energy_model_widget_t energy_model_widgets[CY_CAPSENSE_WIDGET_COUNT] =
+{
+    [CY_CAPSENSE_LINEARSLIDER0_WDGT_ID] =
+    {
+        .scan_time_us       = ENERGY_MODEL_SLIDER_SCAN_TIME_US,
+    #if (defined(FAST_SLIDER_ENABLE))
+        .process_time_us    = ENERGY_MODEL_FAST_SLIDER_PROCESS_TIME_US,
+    #else
+        .process_time_us    = ENERGY_MODEL_SLIDER_PROCESS_TIME_US,
+    #endif /* FAST_SLIDER_ENABLE */
+        .skip_time_us       = ENERGY_MODEL_SLIDER_SKIP_TIME_US
+    },
+    [CY_CAPSENSE_GANGEDSENSOR_WDGT_ID] =
+    {
+        .scan_time_us       = ENERGY_MODEL_GANGED_SCAN_TIME_US,
+        .process_time_us    = ENERGY_MODEL_GANGED_PROCESS_TIME_US,
+        .skip_time_us       = ENERGY_MODEL_GANGED_SKIP_TIME_US
+    }
+};
+
+static energy_model_t energy_model;
+#endif /* ENERGY_MODEL_ENABLE */
 
 TaskHandle_t capsense_task_handle;
 
@@ -147,13 +374,44 @@ static cy_stc_syspm_callback_t capsense_deep_sleep_cb =
  * Function prototypes
  ******************************************************************************/
 static cy_status initialize_capsense(void);
-static bool process_touch(uint32_t widget_id, uint32_t *slider_position);
+static bool process_touch(uint32_t widget_id, uint32_t *slider_position, bool *is_skipped);
 static void capsense_isr(void);
 static void capsense_callback();
+#if (defined(SCAN_LATENCY_STATS_ENABLE) || defined(RESIDENCY_STATS_ENABLE) || defined(TELEMETRY_ENABLE))
+static void process_uart_command(void);
+#endif /* SCAN_LATENCY_STATS_ENABLE || RESIDENCY_STATS_ENABLE || TELEMETRY_ENABLE */
+#if (defined(CAPSENSE_ISR_SCAN_ENABLE) || defined(GANGED_FAST_PATH_ENABLE))
+static int32_t get_max_raw_count_delta(uint32_t widget_id);
+#endif /* CAPSENSE_ISR_SCAN_ENABLE || GANGED_FAST_PATH_ENABLE */
+#if (defined(CAPSENSE_ISR_SCAN_ENABLE))
+static scan_policy_transition_t account_isr_scans(void);
+#endif /* CAPSENSE_ISR_SCAN_ENABLE */
+#if (defined(GANGED_FAST_PATH_ENABLE))
+static bool is_ganged_sensor_idle(void);
+static void update_idle_diff_counts(uint32_t widget_id);
+#endif /* GANGED_FAST_PATH_ENABLE */
+#if (defined(FAST_SLIDER_ENABLE))
+static void initialize_fast_slider(void);
+static bool process_slider_fast(uint16_t *slider_pos);
+#endif /* FAST_SLIDER_ENABLE */
+#if (defined(TELEMETRY_ENABLE))
+static void post_telemetry(uint32_t widget_id, bool is_touched);
+#endif /* TELEMETRY_ENABLE */
+static void start_scan_timer(uint32_t period_ms);
+static void change_scan_timer_period(uint32_t period_ms);
+static bool get_next_scan_wakeup(uint32_t *time_to_next, uint32_t *period);
+#if (defined(SCAN_TRIGGER_LPTIMER))
+static void scan_lptimer_callback(void);
+#else
 static void scan_timer_callback( TimerHandle_t scan_timer_handle );
+#endif /* SCAN_TRIGGER_LPTIMER */
 
 #if (defined(CAPSENSE_TUNER_ENABLE))
 static void initialize_capsense_tuner(void);
+static void publish_tuner_frame(void);
+#if (defined(TUNER_STREAM_ENABLE))
+static void add_tuner_stream_frame(void);
+#endif /* TUNER_STREAM_ENABLE */
 static void handle_ezi2c_tuner_event(void *callback_arg, cyhal_ezi2c_status_t event);
 #endif /* CAPSENSE_TUNER_ENABLE */
 
@@ -185,14 +443,40 @@ void capsense_task(void *arg)
     cy_status status;
     uint32_t slider_position = 0;
     static uint32_t state = INITIATE_SCAN;
-    static bool is_fast_scan_enabled = true;
-    static uint32_t capsense_fast_scan_count = RESET_CAPSENSE_FAST_SCAN_COUNT;
-
-    /* Create a timer instance which is used to inform the CPU when to start the
-     * next scan. Since the example starts in fast scan, the timer period is set
-     * as CAPSENSE_FAST_SCAN_INTERVAL_MS.
+    uint32_t widget_id;
+    uint32_t batch_widget_ids[SCAN_PLAN_MAX_ENTRIES];
+    uint32_t num_batch_widgets;
+    uint32_t skipped_mask;
+    bool is_widget_skipped;
+    bool is_touch_detected;
+    scan_policy_transition_t transition = SCAN_POLICY_NO_CHANGE;
+    scan_policy_transition_t scan_transition;
+
+    scan_policy_init(&scan_policy, scan_policy_tiers,
+                     sizeof(scan_policy_tiers) / sizeof(scan_policy_tiers[0]));
+    scan_plan_init(&scan_plan, &scan_plan_tiers[scan_policy_get_tier(&scan_policy)]);
+#if (defined(TOUCH_PREDICTOR_ENABLE))
+    /* The predictor keeps its clock on the LPTimer, which also counts in
+     * deep sleep.
      */
-    scan_timer_handle = xTimerCreate("Scan Timer", pdMS_TO_TICKS(CAPSENSE_FAST_SCAN_INTERVAL_MS), pdTRUE, (void *) 0, scan_timer_callback);
+    if (CY_RSLT_SUCCESS != lp_timer_init())
+    {
+        CY_ASSERT(0);
+    }
+    touch_predictor_init(&touch_predictor, lp_timer_read());
+#endif /* TOUCH_PREDICTOR_ENABLE */
+#if (defined(ENERGY_MODEL_ENABLE))
+    energy_model_init(&energy_model, energy_model_widgets, CY_CAPSENSE_WIDGET_COUNT);
+#endif /* ENERGY_MODEL_ENABLE */
+#if (defined(SCAN_LATENCY_STATS_ENABLE))
+    scan_stats_init();
+#endif /* SCAN_LATENCY_STATS_ENABLE */
+#if (defined(GESTURE_ENABLE))
+    gesture_init(&slider_gesture);
+#endif /* GESTURE_ENABLE */
+#if (defined(RESIDENCY_STATS_ENABLE))
+    residency_init();
+#endif /* RESIDENCY_STATS_ENABLE */
 
 #if (defined(CAPSENSE_TUNER_ENABLE))
    initialize_capsense_tuner();
@@ -212,28 +496,54 @@ void capsense_task(void *arg)
         CY_ASSERT(0);
     }
 
+#if (defined(FAST_SLIDER_ENABLE))
+    initialize_fast_slider();
+#endif /* FAST_SLIDER_ENABLE */
+
+#if (defined(TUNER_SNAPSHOT_ENABLE))
+    /* Unlike the tuner, the snapshot transport keeps deep sleep allowed. */
+    if (CY_RSLT_SUCCESS != tuner_snapshot_init())
+    {
+        CY_ASSERT(0);
+    }
+#endif /* TUNER_SNAPSHOT_ENABLE */
+
 #if (!defined(CAPSENSE_TUNER_ENABLE))
     /* If tuner is not enabled, call Cy_CapSense_SetupWidget to set up the
      * linear slider in fast scan mode. Cy_CapSense_ScanAllWidgets is not called
      * here because it sets up and scans both the widgets used in this example
      * which results in longer scan times.
      */
-    Cy_CapSense_SetupWidget(CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, &cy_capsense_context);
+    setup_widget_id = scan_policy_get_widget_id(&scan_policy);
+    Cy_CapSense_SetupWidget(setup_widget_id, &cy_capsense_context);
 #endif /* CAPSENSE_TUNER_ENABLE */
 
-    if( pdPASS != xTimerStart( scan_timer_handle, 0 ) )
-    {
-        CY_ASSERT(0);
-    }
+    /* Start the timer which is used to inform the CPU when to start the next
+     * scan. Since the example starts in fast scan, the timer period is set as
+     * CAPSENSE_FAST_SCAN_INTERVAL_MS.
+     */
+    start_scan_timer(scan_policy_get_interval_ms(&scan_policy));
 
     for (;;)
     {
+    #if (defined(RESIDENCY_STATS_ENABLE))
+        /* Attribute the time from here on to the current state and widget. */
+        residency_set_state(state, scan_policy_get_widget_id(&scan_policy));
+    #endif /* RESIDENCY_STATS_ENABLE */
+
         switch(state)
         {
             case INITIATE_SCAN:
 
                 if (CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(&cy_capsense_context))
                 {
+                    SCAN_STATS_MARK(SCAN_STATS_SCAN_START);
+
+                    /* The remaining widgets of the batch are scanned from
+                     * capsense_callback.
+                     */
+                    widget_id = scan_plan_begin_batch(&scan_plan);
+
                     #if (defined(CAPSENSE_TUNER_ENABLE))
                     /* Cy_CapSense_ScanAllWidgets is called when tuner is
                      * enabled to get the status of both the widgets in the
@@ -243,6 +553,11 @@ void capsense_task(void *arg)
                      */
                     Cy_CapSense_ScanAllWidgets(&cy_capsense_context);
                     #else
+                    if (widget_id != setup_widget_id)
+                    {
+                        setup_widget_id = widget_id;
+                        Cy_CapSense_SetupWidget(widget_id, &cy_capsense_context);
+                    }
                     Cy_CapSense_Scan(&cy_capsense_context);
                     #endif /* CAPSENSE_TUNER_ENABLE */
                     state = WAIT_IN_SLEEP;
@@ -276,75 +591,150 @@ void capsense_task(void *arg)
                 break;
 
             case PROCESS_TOUCH:
-                if(is_fast_scan_enabled)
+                /* Process the widgets scanned in the batch and let the scan
+                 * policy decide whether the scan rate has to change. In the
+                 * slider tiers, the Linear Slider widget is processed and a
+                 * new slider position is displayed on the serial terminal. In
+                 * the idle tiers, the Ganged Sensor widget is processed. A
+                 * touch on any widget of the batch counts as a touch.
+                 */
+                widget_id = scan_policy_get_widget_id(&scan_policy);
+                num_batch_widgets = scan_plan_get_batch(&scan_plan, batch_widget_ids);
+
+            #if (defined(CAPSENSE_ISR_SCAN_ENABLE))
+                transition = account_isr_scans();
+            #endif /* CAPSENSE_ISR_SCAN_ENABLE */
+
+            #if (defined(CAPSENSE_TUNER_ENABLE))
+                /* All widgets have been scanned. */
+                Cy_CapSense_ProcessAllWidgets(&cy_capsense_context);
+            #endif /* CAPSENSE_TUNER_ENABLE */
+
+                is_touch_detected = false;
+                skipped_mask = 0U;
+                for (uint32_t i = 0; i < num_batch_widgets; i++)
                 {
-                    /* If new touch is detected, then the value of
-                     * capsense_fast_scan_count is reset to
-                     * RESET_CAPSENSE_FAST_SCAN_COUNT, and the slider position
-                     * is displayed on the serial terminal. If not,
-                     * capsense_fast_scan_count is incremented until
-                     * MAX_CAPSENSE_FAST_SCAN_COUNT after which the timer period
-                     * is changed to CAPSENSE_SLOW_SCAN_INTERVAL_MS and the
-                     * Ganged Sensor widget is set up for the next scan.
-                     */
-                    if(process_touch(CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, &slider_position))
+                #if (defined(SCAN_LATENCY_STATS_ENABLE))
+                    uint32_t process_start = SCAN_STATS_GET_CYCLES();
+                #endif /* SCAN_LATENCY_STATS_ENABLE */
+                    bool is_widget_touched = process_touch(batch_widget_ids[i], &slider_position,
+                                                           &is_widget_skipped);
+
+                #if (defined(SCAN_LATENCY_STATS_ENABLE))
+                    scan_stats_record_processing(batch_widget_ids[i],
+                                                 SCAN_STATS_GET_CYCLES() - process_start);
+                #endif /* SCAN_LATENCY_STATS_ENABLE */
+                    if (is_widget_skipped)
                     {
-                        capsense_fast_scan_count = RESET_CAPSENSE_FAST_SCAN_COUNT;
-                        printf("Slider position = %ld\r\n", (unsigned long)slider_position);
+                        skipped_mask |= 1UL << i;
                     }
-                    else
+
+                    if (is_widget_touched)
                     {
-                        if (MAX_CAPSENSE_FAST_SCAN_COUNT > capsense_fast_scan_count)
-                        {
-                            capsense_fast_scan_count++;
-                        }
-                        else
+                        is_touch_detected = true;
+
+                        if (CY_CAPSENSE_LINEARSLIDER0_WDGT_ID == batch_widget_ids[i])
                         {
-                            is_fast_scan_enabled = false;
-                            printf("Fast scan time-out, switching to slow scan.\r\n");
-                        #if (!defined(CAPSENSE_TUNER_ENABLE))
-                            /* Set up Ganged Sensor widget for the next scan and
-                             * change timer period to
-                             * CAPSENSE_SLOW_SCAN_INTERVAL_MS only if tuner is 
-                             * disabled.
-                             */
-                            Cy_CapSense_SetupWidget(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID, &cy_capsense_context);
-                        #endif
-                            xTimerChangePeriod( scan_timer_handle, CAPSENSE_SLOW_SCAN_INTERVAL_MS, 0 );
+                            touch_event_post(TOUCH_EVENT_SLIDER_POSITION, 0U,
+                                             (uint16_t)slider_position, 0);
                         }
                     }
                 }
-                else
+
+            #if (defined(TUNER_SNAPSHOT_ENABLE))
+                for (uint32_t i = 0; i < num_batch_widgets; i++)
+                {
+                    tuner_snapshot_capture(batch_widget_ids[i], &cy_capsense_context);
+                }
+            #endif /* TUNER_SNAPSHOT_ENABLE */
+                scan_plan_end_batch(&scan_plan);
+
+            #if (defined(SCAN_LATENCY_STATS_ENABLE))
+                scan_stats_complete(widget_id);
+            #endif /* SCAN_LATENCY_STATS_ENABLE */
+
+            #if (defined(SCAN_LATENCY_STATS_ENABLE) || defined(RESIDENCY_STATS_ENABLE) || defined(TELEMETRY_ENABLE))
+                process_uart_command();
+            #endif /* SCAN_LATENCY_STATS_ENABLE || RESIDENCY_STATS_ENABLE || TELEMETRY_ENABLE */
+
+            #if (defined(RUNTIME_STATS_ENABLE))
+                /* Reported after a scan so that the report adds no wake-up. */
+                runtime_stats_report();
+            #endif /* RUNTIME_STATS_ENABLE */
+
+            #if (defined(ENERGY_MODEL_ENABLE))
+                /* Account for the batch with the period it was performed in,
+                 * and the processing path each widget took.
+                 */
+                energy_model_record_batch(&energy_model, batch_widget_ids, num_batch_widgets,
+                                          skipped_mask, scan_policy_get_interval_ms(&scan_policy));
+            #endif /* ENERGY_MODEL_ENABLE */
+
+            #if (defined(TOUCH_PREDICTOR_ENABLE))
+                touch_predictor_update(&touch_predictor, lp_timer_read());
+                if (is_touch_detected)
                 {
-                    /* If a touch is detected for the Ganged Sensor widget, then
-                     * the example switches to fast scan mode by setting up
-                     * Linear slider widget and changing the timer period to 
-                     * CAPSENSE_FAST_SCAN_INTERVAL_MS.
+                    touch_predictor_record_touch(&touch_predictor);
+                }
+                scan_policy_set_hint(&scan_policy,
+                                     touch_predictor_is_touch_expected(&touch_predictor),
+                                     touch_predictor_is_quiet_period(&touch_predictor));
+            #endif /* TOUCH_PREDICTOR_ENABLE */
+
+                scan_transition = scan_policy_update(&scan_policy, is_touch_detected);
+                if (SCAN_POLICY_NO_CHANGE != scan_transition)
+                {
+                    transition = scan_transition;
+                }
+
+                if (SCAN_POLICY_NO_CHANGE != transition)
+                {
+                    touch_event_post(TOUCH_EVENT_SCAN_RATE, (uint8_t)transition,
+                                     (uint16_t)scan_policy_get_interval_ms(&scan_policy),
+                                     (int32_t)widget_id);
+
+                #if (defined(ENERGY_MODEL_ENABLE))
+                    touch_event_post(TOUCH_EVENT_AVERAGE_CURRENT, 0U, 0U,
+                                     (int32_t)energy_model_get_average_current_na(&energy_model));
+                #endif /* ENERGY_MODEL_ENABLE */
+
+                #if (defined(SCAN_TRIGGER_LPTIMER))
+                    touch_event_post(TOUCH_EVENT_TRIGGER_LATENCY, 0U, 0U,
+                                     (int32_t)LP_TIMER_TICKS_TO_US(lp_timer_get_max_latency_ticks()));
+                #endif /* SCAN_TRIGGER_LPTIMER */
+
+                    scan_plan_init(&scan_plan, &scan_plan_tiers[scan_policy_get_tier(&scan_policy)]);
+
+                #if (!defined(CAPSENSE_TUNER_ENABLE))
+                    /* Set up the widget of the new tier for the next scan only
+                     * if tuner is disabled and the widget changes.
                      */
-                    if(process_touch(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID, &slider_position))
+                    if (setup_widget_id != scan_policy_get_widget_id(&scan_policy))
                     {
-                        is_fast_scan_enabled = true;
-                        printf("Touch detected, switching to fast scan.\r\n");
-
-                    #if (!defined(CAPSENSE_TUNER_ENABLE))
-                        /* Set up Linear Slider widget for the next scan, change
-                         * capsense_fast_scan_count to 
-                         * RESET_CAPSENSE_FAST_SCAN_COUNT change timer period to
-                         * CAPSENSE_SLOW_SCAN_INTERVAL_MS only if tuner is 
-                         * disabled.
-                         */
-                        Cy_CapSense_SetupWidget(CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, &cy_capsense_context);
-                    #endif
-                        capsense_fast_scan_count = RESET_CAPSENSE_FAST_SCAN_COUNT;
-                        xTimerChangePeriod( scan_timer_handle, CAPSENSE_FAST_SCAN_INTERVAL_MS, 0 );
+                        setup_widget_id = scan_policy_get_widget_id(&scan_policy);
+                        Cy_CapSense_SetupWidget(setup_widget_id, &cy_capsense_context);
                     }
+                #endif
+                    change_scan_timer_period(scan_policy_get_interval_ms(&scan_policy));
+                    transition = SCAN_POLICY_NO_CHANGE;
                 }
 
+            #if (defined(CAPSENSE_ISR_SCAN_ENABLE))
+                /* Let the ISR handle the scans while only the Ganged Sensor is
+                 * scanned.
+                 */
+                is_isr_scan_enabled = ((CY_CAPSENSE_GANGEDSENSOR_WDGT_ID ==
+                                        scan_policy_get_widget_id(&scan_policy)) &&
+                                       (1U == scan_plan.num_entries));
+            #endif /* CAPSENSE_ISR_SCAN_ENABLE */
+
                 /* Establishes synchronized operation between the CapSense
-                 * middleware and the CapSense Tuner tool.
+                 * middleware and the CapSense Tuner tool, and publishes the
+                 * processed frame to the host.
                  */
                 #if (defined(CAPSENSE_TUNER_ENABLE))
                 Cy_CapSense_RunTuner(&cy_capsense_context);
+                publish_tuner_frame();
                 #endif /* CAPSENSE_TUNER_ENABLE */
                 state = WAIT_IN_DEEP_SLEEP;
                 break;
@@ -368,37 +758,70 @@ void capsense_task(void *arg)
 * Parameters:
 * uint32_t widget_id: The value of the CapSense Widget ID.
 * uint32_t *slider_position: Pointer to variable storing slider position.
+* bool *is_skipped: Set if the processing of the widget was skipped.
 *
 * Return:
 * bool: Status of touch detection.
 *
 *******************************************************************************/
-static bool process_touch(uint32_t widget_id, uint32_t *slider_position)
+static bool process_touch(uint32_t widget_id, uint32_t *slider_position, bool *is_skipped)
 {
+#if (!defined(FAST_SLIDER_ENABLE))
     cy_stc_capsense_touch_t *slider_touch_info;
+#endif /* FAST_SLIDER_ENABLE */
     uint16_t slider_pos;
     uint8_t slider_touch_status;
     bool is_new_touch_detected = false;
     static uint16_t slider_pos_prev;
+#if (defined(GESTURE_ENABLE))
+    gesture_event_t gesture_events[GESTURE_MAX_EVENTS];
+    uint32_t num_gesture_events;
+#endif /* GESTURE_ENABLE */
 
-    /* Process all widgets if tuner is enabled. Otherwise, process the widget
-     * specified by widget_id.
+    /* If tuner is enabled, all widgets have already been processed by
+     * capsense_task. Otherwise, process the widget specified by widget_id.
      */
-#if (!defined(CAPSENSE_TUNER_ENABLE))
+#if (defined(GANGED_FAST_PATH_ENABLE))
+    /* Skip the filters and the baseline update of the Ganged Sensor while
+     * its signal is clearly idle. The difference counts still follow the raw
+     * counts, so that the telemetry and the tuner snapshots are up to date.
+     */
+    if ((CY_CAPSENSE_GANGEDSENSOR_WDGT_ID == widget_id) && is_ganged_sensor_idle())
+    {
+        update_idle_diff_counts(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID);
+    #if (defined(TELEMETRY_ENABLE))
+        post_telemetry(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID, false);
+    #endif /* TELEMETRY_ENABLE */
+        *is_skipped = true;
+        return false;
+    }
+#endif /* GANGED_FAST_PATH_ENABLE */
+    *is_skipped = false;
+
+#if (defined(FAST_SLIDER_ENABLE))
+    /* The slider is processed by process_slider_fast. */
+    if (CY_CAPSENSE_LINEARSLIDER0_WDGT_ID != widget_id)
+    {
+        Cy_CapSense_ProcessWidget(widget_id, &cy_capsense_context);
+    }
+#elif (!defined(CAPSENSE_TUNER_ENABLE))
     Cy_CapSense_ProcessWidget(widget_id, &cy_capsense_context);
-#else
-    Cy_CapSense_ProcessAllWidgets(&cy_capsense_context);
-#endif /* CAPSENSE_TUNER_ENABLE */
+#endif /* FAST_SLIDER_ENABLE */
 
 
     switch(widget_id)
     {
         case CY_CAPSENSE_LINEARSLIDER0_WDGT_ID:
             /* Get slider status. */
+        #if (defined(FAST_SLIDER_ENABLE))
+            slider_pos = slider_pos_prev;
+            slider_touch_status = process_slider_fast(&slider_pos) ? 1U : 0U;
+        #else
             slider_touch_info = Cy_CapSense_GetTouchInfo(
             CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, &cy_capsense_context);
             slider_touch_status = slider_touch_info->numPosition;
             slider_pos = slider_touch_info->ptrPosition->x;
+        #endif /* FAST_SLIDER_ENABLE */
 
             /* Detect the new touch on slider. */
             if ((0 != slider_touch_status) &&
@@ -411,6 +834,22 @@ static bool process_touch(uint32_t widget_id, uint32_t *slider_position)
             /* Update previous touch status. */
             slider_pos_prev = slider_pos;
 
+        #if (defined(TELEMETRY_ENABLE))
+            post_telemetry(CY_CAPSENSE_LINEARSLIDER0_WDGT_ID, (0 != slider_touch_status));
+        #endif /* TELEMETRY_ENABLE */
+
+        #if (defined(GESTURE_ENABLE))
+            /* Feed every slider scan into the gesture recognizer. */
+            num_gesture_events = gesture_update(&slider_gesture, (0 != slider_touch_status), slider_pos,
+                                                (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS),
+                                                gesture_events);
+            for (uint32_t i = 0; i < num_gesture_events; i++)
+            {
+                touch_event_post(TOUCH_EVENT_GESTURE, (uint8_t)gesture_events[i].type,
+                                 gesture_events[i].position, gesture_events[i].velocity);
+            }
+        #endif /* GESTURE_ENABLE */
+
             break;
 
         case CY_CAPSENSE_GANGEDSENSOR_WDGT_ID:
@@ -420,6 +859,10 @@ static bool process_touch(uint32_t widget_id, uint32_t *slider_position)
                 is_new_touch_detected = true;
             }
 
+        #if (defined(TELEMETRY_ENABLE))
+            post_telemetry(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID, is_new_touch_detected);
+        #endif /* TELEMETRY_ENABLE */
+
             break;
 
         default:
@@ -430,6 +873,131 @@ static bool process_touch(uint32_t widget_id, uint32_t *slider_position)
 }
 
 
+#if (defined(TELEMETRY_ENABLE))
+/*******************************************************************************
+* Function Name: post_telemetry
+********************************************************************************
+* Summary:
+*  Posts the touch state of the widget when it changes, and the raw and
+*  difference counts of the sensors that have changed or are due (see
+*  TELEMETRY_COUNTS_TOUCHED_DECIMATION), for the binary telemetry.
+*
+* Parameters:
+*  uint32_t widget_id: ID of the widget that has been processed.
+*  bool is_touched: Whether the widget is touched.
+*
+*******************************************************************************/
+static void post_telemetry(uint32_t widget_id, bool is_touched)
+{
+    static bool is_touched_prev[CY_CAPSENSE_TOTAL_WIDGET_COUNT];
+    const cy_stc_capsense_widget_config_t *widget_config = &cy_capsense_context.ptrWdConfig[widget_id];
+    uint32_t num_sensors = widget_config->numSns;
+    uint32_t min_change = widget_config->ptrWdContext->noiseTh;
+    uint16_t *posted_raw = telemetry_posted_raw[widget_id];
+    bool is_all_due = telemetry_is_counts_requested[widget_id];
+    uint16_t raw;
+    uint32_t change;
+
+    if (is_touched != is_touched_prev[widget_id])
+    {
+        is_touched_prev[widget_id] = is_touched;
+        touch_event_post(TOUCH_EVENT_TOUCH_STATE, (uint8_t)widget_id, is_touched ? 1U : 0U, 0);
+        is_all_due = true;
+        telemetry_touched_scans[widget_id] = 0U;
+    }
+    else if (is_touched && (TELEMETRY_COUNTS_TOUCHED_DECIMATION <= ++telemetry_touched_scans[widget_id]))
+    {
+        is_all_due = true;
+        telemetry_touched_scans[widget_id] = 0U;
+    }
+    else
+    {
+        /* Only the sensors that have changed. */
+    }
+
+    if (num_sensors > TELEMETRY_COUNTS_MAX_SENSORS)
+    {
+        num_sensors = TELEMETRY_COUNTS_MAX_SENSORS;
+    }
+
+    for (uint32_t i = 0; i < num_sensors; i++)
+    {
+        raw = widget_config->ptrSnsContext[i].raw;
+        change = (raw > posted_raw[i]) ? (uint32_t)(raw - posted_raw[i]) : (uint32_t)(posted_raw[i] - raw);
+
+        if (is_all_due || (change > min_change))
+        {
+            posted_raw[i] = raw;
+            touch_event_post(TOUCH_EVENT_SENSOR_COUNTS, (uint8_t)((widget_id << 4) | i),
+                             raw, (int32_t)widget_config->ptrSnsContext[i].diff);
+        }
+    }
+
+    telemetry_is_counts_requested[widget_id] = false;
+}
+#endif /* TELEMETRY_ENABLE */
+
+
+#if (defined(SCAN_LATENCY_STATS_ENABLE) || defined(RESIDENCY_STATS_ENABLE) || defined(TELEMETRY_ENABLE))
+/*******************************************************************************
+* Function Name: process_uart_command
+********************************************************************************
+* Summary: Prints the requested statistics, or requests the sensor counts of
+* every widget for the telemetry, if a command character has been received on
+* the debug UART. UART reception does not wake the device, so the command is
+* handled at the next processed scan.
+*
+*******************************************************************************/
+static void process_uart_command(void)
+{
+    uint8_t uart_read_value;
+
+    if ((0U == cyhal_uart_readable(&cy_retarget_io_uart_obj)) ||
+        (CY_RSLT_SUCCESS != cyhal_uart_getc(&cy_retarget_io_uart_obj, &uart_read_value, 0)))
+    {
+        return;
+    }
+
+#if (defined(UART_TX_DMA_ENABLE))
+    /* The statistics are printed with the blocking printf. Let the queued
+     * output drain first so that the two do not interleave.
+     */
+    uart_tx_flush();
+#endif /* UART_TX_DMA_ENABLE */
+
+    switch (uart_read_value)
+    {
+    #if (defined(SCAN_LATENCY_STATS_ENABLE))
+        case UART_CMD_PRINT_SCAN_STATS:
+            scan_stats_print();
+            break;
+    #endif /* SCAN_LATENCY_STATS_ENABLE */
+
+    #if (defined(RESIDENCY_STATS_ENABLE))
+        case UART_CMD_PRINT_RESIDENCY:
+            residency_print(residency_state_names,
+                            sizeof(residency_state_names) / sizeof(residency_state_names[0]));
+            printf("Wake-ups aligned with a scan: %lu\r\n",
+                   (unsigned long)wake_coalesce_get_aligned_count());
+            break;
+    #endif /* RESIDENCY_STATS_ENABLE */
+
+    #if (defined(TELEMETRY_ENABLE))
+        case UART_CMD_SEND_COUNTS:
+            for (uint32_t i = 0; i < CY_CAPSENSE_TOTAL_WIDGET_COUNT; i++)
+            {
+                telemetry_is_counts_requested[i] = true;
+            }
+            break;
+    #endif /* TELEMETRY_ENABLE */
+
+        default:
+            break;
+    }
+}
+#endif /* SCAN_LATENCY_STATS_ENABLE || RESIDENCY_STATS_ENABLE || TELEMETRY_ENABLE */
+
+
 /*******************************************************************************
 * Function Name: initialize_capsense
 ********************************************************************************
@@ -514,6 +1082,50 @@ static void capsense_callback(cy_stc_active_scan_sns_t * ptrActiveScan)
 {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     uint32_t notify_state_change = PROCESS_TOUCH;
+#if (!defined(CAPSENSE_TUNER_ENABLE))
+    uint32_t widget_id;
+
+    /* Chain the scan of the next widget of the batch without waking the
+     * task. Deep sleep stays locked by the task until the batch is complete.
+     */
+    if (scan_plan_get_next(&scan_plan, &widget_id))
+    {
+        if (widget_id != setup_widget_id)
+        {
+            setup_widget_id = widget_id;
+            Cy_CapSense_SetupWidget(widget_id, &cy_capsense_context);
+        }
+        Cy_CapSense_Scan(&cy_capsense_context);
+        return;
+    }
+#endif /* CAPSENSE_TUNER_ENABLE */
+
+    SCAN_STATS_MARK(SCAN_STATS_SCAN_END);
+
+#if (defined(CAPSENSE_ISR_SCAN_ENABLE))
+    if (is_isr_scan_active)
+    {
+        is_isr_scan_active = false;
+
+        if ((CAPSENSE_ISR_MAX_SKIPPED_SCANS > (isr_skipped_scan_count + 1U)) &&
+            (get_max_raw_count_delta(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID) <
+             (int32_t)((cy_capsense_context.ptrWdConfig[CY_CAPSENSE_GANGEDSENSOR_WDGT_ID].ptrWdContext->fingerTh *
+                        CAPSENSE_ISR_WAKE_THRESHOLD_PERCENT) / 100U)))
+        {
+            /* Nothing happened, go back to deep sleep without waking the
+             * task.
+             */
+            isr_skipped_scan_count++;
+            cyhal_syspm_unlock_deepsleep();
+            return;
+        }
+
+        /* Hand the scan over to the task. The deep sleep lock taken in
+         * scan_lptimer_callback is released by the task in WAIT_IN_DEEP_SLEEP.
+         */
+        is_isr_scan_enabled = false;
+    }
+#endif /* CAPSENSE_ISR_SCAN_ENABLE */
 
     /* Notify the capsense_task that scan has completed. */
     xTaskNotifyFromISR(capsense_task_handle, notify_state_change, eSetValueWithOverwrite,
@@ -523,6 +1135,358 @@ static void capsense_callback(cy_stc_active_scan_sns_t * ptrActiveScan)
 }
 
 
+#if (defined(CAPSENSE_ISR_SCAN_ENABLE) || defined(GANGED_FAST_PATH_ENABLE))
+/*******************************************************************************
+* Function Name: get_max_raw_count_delta
+********************************************************************************
+* Summary:
+*  Returns the largest difference between the raw count and the baseline over
+*  the sensors of the widget specified by widget_id. Unlike the difference
+*  counts, this does not require the widget to be processed.
+*
+* Parameters:
+*  uint32_t widget_id: The value of the CapSense Widget ID.
+*
+*******************************************************************************/
+static int32_t get_max_raw_count_delta(uint32_t widget_id)
+{
+    const cy_stc_capsense_widget_config_t *widget_config = &cy_capsense_context.ptrWdConfig[widget_id];
+    int32_t max_delta = INT32_MIN;
+    int32_t delta;
+
+    for (uint32_t i = 0; i < widget_config->numSns; i++)
+    {
+        delta = (int32_t)widget_config->ptrSnsContext[i].raw -
+                (int32_t)widget_config->ptrSnsContext[i].bsln;
+        if (delta > max_delta)
+        {
+            max_delta = delta;
+        }
+    }
+
+    return max_delta;
+}
+#endif /* CAPSENSE_ISR_SCAN_ENABLE || GANGED_FAST_PATH_ENABLE */
+
+
+#if (defined(GANGED_FAST_PATH_ENABLE))
+/*******************************************************************************
+* Function Name: is_ganged_sensor_idle
+********************************************************************************
+* Summary:
+*  Fast-path wake detector for the Ganged Sensor. Compares the raw count with
+*  the baseline, with hysteresis, to decide whether the full processing can be
+*  skipped for the current scan.
+*
+* Return:
+*  bool: true if the signal is outside of the proximity band and the full
+*  processing is not due.
+*
+*******************************************************************************/
+static bool is_ganged_sensor_idle(void)
+{
+    static bool is_in_band = false;
+    static uint32_t skipped_scan_count = 0;
+    uint32_t finger_th = cy_capsense_context.ptrWdConfig[CY_CAPSENSE_GANGEDSENSOR_WDGT_ID].ptrWdContext->fingerTh;
+    int32_t delta = get_max_raw_count_delta(CY_CAPSENSE_GANGEDSENSOR_WDGT_ID);
+
+    if (is_in_band)
+    {
+        is_in_band = (delta >= (int32_t)((finger_th * GANGED_FAST_PATH_EXIT_PERCENT) / 100U));
+    }
+    else
+    {
+        is_in_band = (delta >= (int32_t)((finger_th * GANGED_FAST_PATH_ENTER_PERCENT) / 100U));
+    }
+
+    if (is_in_band || (GANGED_FAST_PATH_MAX_SKIPPED_SCANS <= (skipped_scan_count + 1U)))
+    {
+        skipped_scan_count = 0;
+        return false;
+    }
+
+    skipped_scan_count++;
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: update_idle_diff_counts
+********************************************************************************
+* Summary:
+*  Sets the difference counts of the sensors of a widget whose processing is
+*  skipped to the raw count minus the baseline, limited at 0 as by the
+*  middleware. The baseline and the status are left unchanged; the widget is
+*  outside of the proximity band, so it is not touched.
+*
+* Parameters:
+*  uint32_t widget_id: The value of the CapSense Widget ID.
+*
+*******************************************************************************/
+static void update_idle_diff_counts(uint32_t widget_id)
+{
+    const cy_stc_capsense_widget_config_t *widget_config = &cy_capsense_context.ptrWdConfig[widget_id];
+    cy_stc_capsense_sensor_context_t *sensor;
+
+    for (uint32_t i = 0; i < widget_config->numSns; i++)
+    {
+        sensor = &widget_config->ptrSnsContext[i];
+        sensor->diff = (sensor->raw > sensor->bsln) ? (uint16_t)(sensor->raw - sensor->bsln) : 0U;
+    }
+}
+#endif /* GANGED_FAST_PATH_ENABLE */
+
+
+#if (defined(FAST_SLIDER_ENABLE))
+/*******************************************************************************
+* Function Name: initialize_fast_slider
+********************************************************************************
+* Summary:
+*  Initializes the fixed-point slider kernels with the parameters of
+*  LinearSlider0 from the CapSense configuration.
+*
+*******************************************************************************/
+static void initialize_fast_slider(void)
+{
+    const cy_stc_capsense_widget_config_t *widget_config =
+        &cy_capsense_context.ptrWdConfig[CY_CAPSENSE_LINEARSLIDER0_WDGT_ID];
+    fast_slider_config_t config =
+    {
+        .num_sensors    = widget_config->numSns,
+        .resolution     = widget_config->xResolution,
+        .finger_th      = widget_config->ptrWdContext->fingerTh,
+        .hysteresis     = widget_config->ptrWdContext->hysteresis,
+        .noise_th       = widget_config->ptrWdContext->noiseTh
+    };
+
+    fast_slider_init(&fast_slider, &config);
+}
+
+
+/*******************************************************************************
+* Function Name: process_slider_fast
+********************************************************************************
+* Summary:
+*  Processes LinearSlider0 with the fixed-point kernels of fast_slider.c. The
+*  raw counts are filtered in place, the middleware updates only the baseline
+*  and the difference counts, and the touch status and the centroid are
+*  computed by fast_slider_get_position. The touch information of the
+*  middleware is not updated.
+*
+* Parameters:
+*  uint16_t *slider_pos: Returns the slider position if touched.
+*
+* Return:
+*  bool: Whether the slider is touched.
+*
+*******************************************************************************/
+static bool process_slider_fast(uint16_t *slider_pos)
+{
+    const cy_stc_capsense_widget_config_t *widget_config =
+        &cy_capsense_context.ptrWdConfig[CY_CAPSENSE_LINEARSLIDER0_WDGT_ID];
+    uint16_t counts[FAST_SLIDER_MAX_SENSORS];
+    uint32_t num_sensors = fast_slider.config.num_sensors;
+
+    for (uint32_t i = 0; i < num_sensors; i++)
+    {
+        counts[i] = widget_config->ptrSnsContext[i].raw;
+    }
+
+    fast_slider_filter(&fast_slider, counts);
+
+    for (uint32_t i = 0; i < num_sensors; i++)
+    {
+        widget_config->ptrSnsContext[i].raw = counts[i];
+    }
+
+    Cy_CapSense_ProcessWidgetExt(CY_CAPSENSE_LINEARSLIDER0_WDGT_ID,
+                                 CY_CAPSENSE_PROCESS_BASELINE | CY_CAPSENSE_PROCESS_DIFFCOUNTS,
+                                 &cy_capsense_context);
+
+    for (uint32_t i = 0; i < num_sensors; i++)
+    {
+        counts[i] = widget_config->ptrSnsContext[i].diff;
+    }
+
+    return fast_slider_get_position(&fast_slider, counts, slider_pos);
+}
+#endif /* FAST_SLIDER_ENABLE */
+
+
+#if (defined(CAPSENSE_ISR_SCAN_ENABLE))
+/*******************************************************************************
+* Function Name: account_isr_scans
+********************************************************************************
+* Summary:
+*  Feeds the scans that were completed in the ISR without waking the task into
+*  the scan policy (and the energy model if enabled) as scans without touch.
+*
+* Return:
+*  scan_policy_transition_t: The last tier transition caused by these scans.
+*
+*******************************************************************************/
+static scan_policy_transition_t account_isr_scans(void)
+{
+    scan_policy_transition_t transition = SCAN_POLICY_NO_CHANGE;
+    scan_policy_transition_t scan_transition;
+    uint32_t skipped_scan_count;
+
+    /* The ISR does not update the counter while is_isr_scan_enabled is
+     * cleared.
+     */
+    skipped_scan_count = isr_skipped_scan_count;
+    isr_skipped_scan_count = 0;
+
+    while (0U != skipped_scan_count--)
+    {
+    #if (defined(ENERGY_MODEL_ENABLE))
+        energy_model_record_scan(&energy_model, scan_policy_get_widget_id(&scan_policy),
+                                 true, scan_policy_get_interval_ms(&scan_policy));
+    #endif /* ENERGY_MODEL_ENABLE */
+
+        scan_transition = scan_policy_update(&scan_policy, false);
+        if (SCAN_POLICY_NO_CHANGE != scan_transition)
+        {
+            transition = scan_transition;
+        }
+    }
+
+    return transition;
+}
+#endif /* CAPSENSE_ISR_SCAN_ENABLE */
+
+
+/*******************************************************************************
+* Function Name: start_scan_timer
+********************************************************************************
+* Summary:
+*  Starts the periodic timer that triggers the scans. By default, a FreeRTOS
+*  software timer is used. If SCAN_TRIGGER_LPTIMER is defined, the scans are
+*  triggered directly from the deep-sleep-capable LPTimer interrupt, which
+*  removes the timer daemon task from the scan path.
+*
+* Parameters:
+*  uint32_t period_ms : timer period.
+*
+*******************************************************************************/
+static void start_scan_timer(uint32_t period_ms)
+{
+#if (defined(SCAN_TRIGGER_LPTIMER))
+    if (CY_RSLT_SUCCESS != lp_timer_init())
+    {
+        CY_ASSERT(0);
+    }
+
+    lp_timer_start_periodic(period_ms, scan_lptimer_callback);
+
+    /* Let the other tasks align their wake-ups with the scans. */
+    wake_coalesce_set_anchor(get_next_scan_wakeup, LP_TIMER_FREQ_HZ);
+#else
+#if (defined(STATIC_ALLOCATION_ONLY))
+    scan_timer_handle = xTimerCreateStatic("Scan Timer", pdMS_TO_TICKS(period_ms), pdTRUE, (void *) 0,
+                                           scan_timer_callback, &scan_timer_buffer);
+#else
+    scan_timer_handle = xTimerCreate("Scan Timer", pdMS_TO_TICKS(period_ms), pdTRUE, (void *) 0, scan_timer_callback);
+#endif /* STATIC_ALLOCATION_ONLY */
+
+    if( pdPASS != xTimerStart( scan_timer_handle, 0 ) )
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Let the other tasks align their wake-ups with the scans. */
+    wake_coalesce_set_anchor(get_next_scan_wakeup, configTICK_RATE_HZ);
+#endif /* SCAN_TRIGGER_LPTIMER */
+}
+
+
+/*******************************************************************************
+* Function Name: change_scan_timer_period
+********************************************************************************
+* Summary:
+*  Changes the period of the timer that triggers the scans.
+*
+* Parameters:
+*  uint32_t period_ms : new timer period.
+*
+*******************************************************************************/
+static void change_scan_timer_period(uint32_t period_ms)
+{
+#if (defined(SCAN_TRIGGER_LPTIMER))
+    lp_timer_change_period(period_ms);
+#else
+    xTimerChangePeriod(scan_timer_handle, pdMS_TO_TICKS(period_ms), 0);
+#endif /* SCAN_TRIGGER_LPTIMER */
+}
+
+
+/*******************************************************************************
+* Function Name: get_next_scan_wakeup
+********************************************************************************
+* Summary:
+*  Returns the time to the next expiry of the scan timer and its period, in
+*  LPTimer ticks with SCAN_TRIGGER_LPTIMER and in RTOS ticks otherwise.
+*  Registered as the anchor of the wake-up coalescing.
+*
+* Parameters:
+*  uint32_t *time_to_next : time to the next scan trigger.
+*  uint32_t *period : scan timer period.
+*
+*******************************************************************************/
+static bool get_next_scan_wakeup(uint32_t *time_to_next, uint32_t *period)
+{
+#if (defined(SCAN_TRIGGER_LPTIMER))
+    return lp_timer_get_ticks_to_match(time_to_next, period);
+#else
+    bool is_active = (pdFALSE != xTimerIsTimerActive(scan_timer_handle));
+
+    *time_to_next = (uint32_t)(xTimerGetExpiryTime(scan_timer_handle) - xTaskGetTickCount());
+    *period = (uint32_t)xTimerGetPeriod(scan_timer_handle);
+
+    return is_active;
+#endif /* SCAN_TRIGGER_LPTIMER */
+}
+
+
+#if (defined(SCAN_TRIGGER_LPTIMER))
+/*******************************************************************************
+* Function Name: scan_lptimer_callback()
+********************************************************************************
+* Summary:
+*  This function is called from the LPTimer interrupt at the end of every timer
+*  period. This function writes to the notification value during task
+*  notification to indicate start of a new scan.
+*
+*******************************************************************************/
+static void scan_lptimer_callback(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t notify_state_change = INITIATE_SCAN;
+
+    SCAN_STATS_MARK(SCAN_STATS_TRIGGER);
+
+#if (defined(CAPSENSE_ISR_SCAN_ENABLE))
+    if (is_isr_scan_enabled && (CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(&cy_capsense_context)))
+    {
+        /* Start the scan without waking the task. Deep sleep is locked until
+         * the end of scan.
+         */
+        cyhal_syspm_lock_deepsleep();
+        is_isr_scan_active = true;
+        SCAN_STATS_MARK(SCAN_STATS_SCAN_START);
+        Cy_CapSense_Scan(&cy_capsense_context);
+        return;
+    }
+#endif /* CAPSENSE_ISR_SCAN_ENABLE */
+
+    /* Notify capsense_task to start a new scan. */
+    xTaskNotifyFromISR(capsense_task_handle, notify_state_change, eSetValueWithOverwrite,
+                       &xHigherPriorityTaskWoken);
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+#else
 /*******************************************************************************
 * Function Name: scan_timer_callback()
 ********************************************************************************
@@ -539,43 +1503,130 @@ static void scan_timer_callback( TimerHandle_t scan_timer_handle )
 {
     uint32_t notify_state_change = INITIATE_SCAN;
 
+    SCAN_STATS_MARK(SCAN_STATS_TRIGGER);
+
     /* Notify capsense_task to start a new scan. */
     xTaskNotify(capsense_task_handle, notify_state_change, eSetValueWithOverwrite);
 }
+#endif /* SCAN_TRIGGER_LPTIMER */
 
 
 #if (defined(CAPSENSE_TUNER_ENABLE))
 /*******************************************************************************
-* Function Name: ezi2c_isr
+* Function Name: publish_tuner_frame
+********************************************************************************
+* Summary:
+*  Copies cy_capsense_tuner to the back buffer and makes it the EZI2C buffer.
+*  The buffers are swapped only while no transfer is in progress, so the host
+*  always reads a complete frame. If the bus is busy, the frame is skipped and
+*  the host keeps reading the previous one.
+*
+*******************************************************************************/
+static void publish_tuner_frame(void)
+{
+    uint32_t back = tuner_front ^ 1U;
+    uint32_t interrupt_state;
+
+    tuner_buffer[back] = cy_capsense_tuner;
+
+#if (defined(TUNER_STREAM_ENABLE))
+    add_tuner_stream_frame();
+#endif /* TUNER_STREAM_ENABLE */
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    if (0U == (CYHAL_EZI2C_STATUS_BUSY & cyhal_ezi2c_get_activity_status(&sEzI2C)))
+    {
+        Cy_SCB_EZI2C_SetBuffer1(sEzI2C.base, (uint8_t *)&tuner_buffer[back],
+                                sizeof(cy_capsense_tuner), sizeof(cy_capsense_tuner),
+                                &sEzI2C.context);
+        tuner_shadow = tuner_buffer[back];
+        tuner_front = back;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+#if (defined(TUNER_STREAM_ENABLE))
+/*******************************************************************************
+* Function Name: add_tuner_stream_frame
 ********************************************************************************
 * Summary:
-*  Wrapper function for handling interrupts from EZI2C block.
+*  Adds the raw counts, baselines, and difference counts of all sensors to the
+*  stream. The sensors are ordered by widget.
+*
+*******************************************************************************/
+static void add_tuner_stream_frame(void)
+{
+    uint16_t values[TUNER_STREAM_MAX_VALUES];
+    uint32_t num_values = 0U;
+
+    for (uint32_t widget_id = 0; widget_id < CY_CAPSENSE_TOTAL_WIDGET_COUNT; widget_id++)
+    {
+        const cy_stc_capsense_widget_config_t *widget_config = &cy_capsense_context.ptrWdConfig[widget_id];
+
+        for (uint32_t i = 0; (i < widget_config->numSns) &&
+                             ((num_values + TUNER_STREAM_NUM_FIELDS) <= TUNER_STREAM_MAX_VALUES); i++)
+        {
+            values[num_values++] = widget_config->ptrSnsContext[i].raw;
+            values[num_values++] = widget_config->ptrSnsContext[i].bsln;
+            values[num_values++] = widget_config->ptrSnsContext[i].diff;
+        }
+    }
+
+    (void)tuner_stream_add_frame(&tuner_stream,
+                                 (uint16_t)cy_capsense_context.ptrCommonContext->scanCounter,
+                                 values, num_values);
+}
+#endif /* TUNER_STREAM_ENABLE */
+
+
+/*******************************************************************************
+* Function Name: handle_ezi2c_tuner_event
+********************************************************************************
+* Summary:
+*  Applies the bytes written by the host to the front buffer to
+*  cy_capsense_tuner, so that the tuner commands reach the middleware even while
+*  Cy_CapSense_RunTuner waits for them.
 *
 *******************************************************************************/
 static void handle_ezi2c_tuner_event(void *callback_arg, cyhal_ezi2c_status_t event)
 {
-    cyhal_ezi2c_status_t status;
-    cy_stc_scb_ezi2c_context_t *context = &ezi2c_context;
+    const uint8_t *front = (const uint8_t *)&tuner_buffer[tuner_front];
+    uint8_t *shadow = (uint8_t *)&tuner_shadow;
+    uint8_t *tuner = (uint8_t *)&cy_capsense_tuner;
 
-    /* Get the slave interrupt sources. */
-    status = cyhal_ezi2c_get_activity_status(&sEzI2C);
+    (void)callback_arg;
 
     /* Handle the error conditions. */
-    if (0UL != (CYHAL_EZI2C_STATUS_ERR & status))
+    if (0UL != (CYHAL_EZI2C_STATUS_ERR & event))
     {
         CY_ASSERT(0);
     }
 
     /* Handle the receive direction (master writes data). */
-    if (0 != (CYHAL_EZI2C_STATUS_READ1 & status))
+    if (0UL != (CYHAL_EZI2C_STATUS_WRITE1 & event))
     {
-        cyhal_i2c_slave_config_write_buffer((cyhal_i2c_t *)&sEzI2C, context->curBuf, context->bufSize);
+        for (uint32_t i = 0; i < sizeof(cy_capsense_tuner); i++)
+        {
+            if (front[i] != shadow[i])
+            {
+                tuner[i] = front[i];
+                shadow[i] = front[i];
+            }
+        }
     }
-    /* Handle the transmit direction (master reads data). */
-    if (0 != (CYHAL_EZI2C_STATUS_WRITE1 & status))
+
+#if (defined(TUNER_STREAM_ENABLE))
+    /* The host asks for the frames produced since the previous window. */
+    if ((0UL != (CYHAL_EZI2C_STATUS_WRITE2 & event)) &&
+        (TUNER_STREAM_CMD_NEXT == tuner_stream_window.command))
     {
-        cyhal_i2c_slave_config_read_buffer((cyhal_i2c_t *)&sEzI2C, context->curBuf, context->bufSize);
+        tuner_stream_fill_window(&tuner_stream, &tuner_stream_window);
+        tuner_stream_window.command = TUNER_STREAM_CMD_NONE;
     }
+#endif /* TUNER_STREAM_ENABLE */
 }
 
 
@@ -590,8 +1641,14 @@ static void initialize_capsense_tuner(void)
 {
     cy_rslt_t result;
 
-    /* Configure Capsense Tuner as EzI2C Slave. */
-    sEzI2C_sub_cfg.buf = (uint8 *)&cy_capsense_tuner;
+    tuner_front = 0U;
+    tuner_buffer[tuner_front] = cy_capsense_tuner;
+    tuner_shadow = cy_capsense_tuner;
+
+    /* Configure Capsense Tuner as EzI2C Slave. The host accesses the published
+     * frame, not cy_capsense_tuner itself.
+     */
+    sEzI2C_sub_cfg.buf = (uint8 *)&tuner_buffer[tuner_front];
     sEzI2C_sub_cfg.buf_rw_boundary = sizeof(cy_capsense_tuner);
     sEzI2C_sub_cfg.buf_size = sizeof(cy_capsense_tuner);
     sEzI2C_sub_cfg.slave_address = 8U;
@@ -601,7 +1658,19 @@ static void initialize_capsense_tuner(void)
     sEzI2C_cfg.enable_wake_from_sleep = false;
     sEzI2C_cfg.slave1_cfg = sEzI2C_sub_cfg;
     sEzI2C_cfg.sub_address_size = CYHAL_EZI2C_SUB_ADDR16_BITS;
+#if (defined(TUNER_STREAM_ENABLE))
+    /* Serve the streaming window on the second address. Only the command
+     * register is writable.
+     */
+    tuner_stream_init(&tuner_stream);
+    sEzI2C_cfg.slave2_cfg.buf = (uint8 *)&tuner_stream_window;
+    sEzI2C_cfg.slave2_cfg.buf_rw_boundary = sizeof(tuner_stream_window.command);
+    sEzI2C_cfg.slave2_cfg.buf_size = sizeof(tuner_stream_window);
+    sEzI2C_cfg.slave2_cfg.slave_address = TUNER_STREAM_I2C_ADDRESS;
+    sEzI2C_cfg.two_addresses = true;
+#else
     sEzI2C_cfg.two_addresses = false;
+#endif /* TUNER_STREAM_ENABLE */
     result = cyhal_ezi2c_init( &sEzI2C, CYBSP_I2C_SDA, CYBSP_I2C_SCL, NULL, &sEzI2C_cfg);
 
     if (result != CY_RSLT_SUCCESS)
@@ -611,7 +1680,7 @@ static void initialize_capsense_tuner(void)
 
     cyhal_ezi2c_register_callback( &sEzI2C, handle_ezi2c_tuner_event, NULL);
     cyhal_ezi2c_enable_event(&sEzI2C,
-                             (CYHAL_EZI2C_STATUS_ERR | CYHAL_EZI2C_STATUS_WRITE1 | CYHAL_EZI2C_STATUS_READ1),
+                             (CYHAL_EZI2C_STATUS_ERR | CYHAL_EZI2C_STATUS_WRITE1 | CYHAL_EZI2C_STATUS_WRITE2),
                              EZI2C_INTERRUPT_PRIORITY, true);
 
 }
@@ -64,7 +64,7 @@
  */
 #define EZI2C_INTERRUPT_PRIORITY        (7u)
 
-#define CAPSENSE_TASK_STACK_SIZE_BYTES  (512)
+#define CAPSENSE_TASK_STACK_SIZE_WORDS  (512)
 #define CAPSENSE_TASK_PRIORITY          (3U)
 
 
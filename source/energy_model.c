@@ -0,0 +1,203 @@
+/******************************************************************************
+* File Name:   energy_model.c
+*
+* Description: This file contains function definitions of the scan-loop energy
+*              model. Every scan accounts for one scan timer period, split into
+*              the INITIATE_SCAN/WAIT_IN_SLEEP, PROCESS_TOUCH and
+*              WAIT_IN_DEEP_SLEEP phases of capsense_task, and the model reports
+*              the resulting average current.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "energy_model.h"
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: energy_model_init
+********************************************************************************
+* Summary: Initializes the energy model with the per-widget coefficients and
+* clears the accumulated charge.
+*
+* Parameters:
+* energy_model_t *model: Pointer to the energy model state.
+* const energy_model_widget_t *widgets: Coefficient table indexed by widget ID.
+* uint32_t num_widgets: Number of entries in the coefficient table.
+*
+*******************************************************************************/
+void energy_model_init(energy_model_t *model, const energy_model_widget_t *widgets,
+                       uint32_t num_widgets)
+{
+    model->widgets = widgets;
+    model->num_widgets = num_widgets;
+
+    model->scan_charge_pc = 0;
+    model->process_charge_pc = 0;
+    model->deepsleep_charge_pc = 0;
+    model->total_time_us = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: energy_model_record_scan
+********************************************************************************
+* Summary: Accounts for one scan of widget_id performed with a scan timer period
+* of interval_ms. The part of the period that is not spent scanning or
+* processing is accounted as system deep sleep.
+*
+* Parameters:
+* energy_model_t *model: Pointer to the energy model state.
+* uint32_t widget_id: Widget that was scanned.
+* bool is_skipped: The processing of the scan was skipped.
+* uint32_t interval_ms: Scan timer period at the time of the scan.
+*
+*******************************************************************************/
+void energy_model_record_scan(energy_model_t *model, uint32_t widget_id,
+                              bool is_skipped, uint32_t interval_ms)
+{
+    energy_model_record_batch(model, &widget_id, 1U, is_skipped ? 1U : 0U, interval_ms);
+}
+
+
+/*******************************************************************************
+* Function Name: energy_model_record_batch
+********************************************************************************
+* Summary: Accounts for a batch of scans of the widgets in widget_ids performed
+* in a single scan timer period of interval_ms, with the per-widget
+* coefficients. The processing time of a widget is its skip time if its
+* processing was skipped.
+*
+* Parameters:
+* energy_model_t *model: Pointer to the energy model state.
+* const uint32_t *widget_ids: Widgets that were scanned.
+* uint32_t num_widgets: Number of entries in widget_ids.
+* uint32_t skipped_mask: Bit i is set if the processing of widget_ids[i] was
+* skipped.
+* uint32_t interval_ms: Scan timer period at the time of the batch.
+*
+*******************************************************************************/
+void energy_model_record_batch(energy_model_t *model, const uint32_t *widget_ids,
+                               uint32_t num_widgets, uint32_t skipped_mask,
+                               uint32_t interval_ms)
+{
+    uint32_t scan_time_us = 0;
+    uint32_t process_time_us = 0;
+
+    for (uint32_t i = 0; i < num_widgets; i++)
+    {
+        if (widget_ids[i] < model->num_widgets)
+        {
+            scan_time_us += model->widgets[widget_ids[i]].scan_time_us;
+            process_time_us += (0U != (skipped_mask & (1UL << i))) ?
+                               model->widgets[widget_ids[i]].skip_time_us :
+                               model->widgets[widget_ids[i]].process_time_us;
+        }
+    }
+
+    energy_model_record_period(model, scan_time_us, process_time_us, interval_ms * 1000U);
+}
+
+
+/*******************************************************************************
+* Function Name: energy_model_record_period
+********************************************************************************
+* Summary: Accounts for a scan timer period of period_us with measured scan and
+* processing times, for a caller that can measure them. The part of the period
+* that is not spent scanning or processing is accounted as system deep sleep.
+*
+* Parameters:
+* energy_model_t *model: Pointer to the energy model state.
+* uint32_t scan_time_us: Time spent scanning with the CPU in sleep.
+* uint32_t process_time_us: Time spent with the CPU active.
+* uint32_t period_us: Scan timer period.
+*
+*******************************************************************************/
+void energy_model_record_period(energy_model_t *model, uint32_t scan_time_us,
+                                uint32_t process_time_us, uint32_t period_us)
+{
+    uint32_t deepsleep_time_us = 0;
+
+    /* A batch that takes longer than the timer period leaves no time for deep
+     * sleep and stretches the period.
+     */
+    if (period_us > (scan_time_us + process_time_us))
+    {
+        deepsleep_time_us = period_us - (scan_time_us + process_time_us);
+    }
+
+    model->scan_charge_pc += (uint64_t)scan_time_us * ENERGY_MODEL_SCAN_CURRENT_UA;
+    model->process_charge_pc += (uint64_t)process_time_us * ENERGY_MODEL_PROCESS_CURRENT_UA;
+    model->deepsleep_charge_pc += (uint64_t)deepsleep_time_us * ENERGY_MODEL_DEEPSLEEP_CURRENT_UA;
+    model->total_time_us += (uint64_t)scan_time_us + process_time_us + deepsleep_time_us;
+}
+
+
+/*******************************************************************************
+* Function Name: energy_model_get_average_current_na
+********************************************************************************
+* Summary: Returns the modeled average current over all recorded scans.
+*
+* Parameters:
+* const energy_model_t *model: Pointer to the energy model state.
+*
+* Return:
+* uint32_t: Average current in nA, or 0 if no scan has been recorded.
+*
+*******************************************************************************/
+uint32_t energy_model_get_average_current_na(const energy_model_t *model)
+{
+    uint64_t total_charge_pc;
+
+    if (0U == model->total_time_us)
+    {
+        return 0U;
+    }
+
+    total_charge_pc = model->scan_charge_pc + model->process_charge_pc +
+                      model->deepsleep_charge_pc;
+
+    return (uint32_t)((total_charge_pc * 1000U) / model->total_time_us);
+}
+
+
+/* [] END OF FILE */
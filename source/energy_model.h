@@ -0,0 +1,131 @@
+/******************************************************************************
+* File Name:   energy_model.h
+*
+* Description: This file contains the data types, default coefficients and
+*              function prototypes of the scan-loop energy model.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_ENERGY_MODEL_H
+#define SOURCE_ENERGY_MODEL_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+/* The energy model does not depend on the PDL, HAL, CapSense middleware or
+ * FreeRTOS, in the same way as the scan policy.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Per-state current coefficients. The defaults are derived from the typical
+ * fast/slow scan current values of CY8CKIT-062-BLE listed in README.md (CM4 at
+ * 48 MHz, ULP, Minimum Current Buck) and should be recalibrated for other kits
+ * and clock configurations.
+ *
+ * ENERGY_MODEL_SCAN_CURRENT_UA: CPU sleep with the CSD block scanning
+ * (WAIT_IN_SLEEP).
+ * ENERGY_MODEL_PROCESS_CURRENT_UA: CPU active while processing the scan data
+ * (PROCESS_TOUCH).
+ * ENERGY_MODEL_DEEPSLEEP_CURRENT_UA: System deep sleep between the scans
+ * (WAIT_IN_DEEP_SLEEP).
+ */
+#define ENERGY_MODEL_SCAN_CURRENT_UA         (1200U)
+#define ENERGY_MODEL_PROCESS_CURRENT_UA      (2000U)
+#define ENERGY_MODEL_DEEPSLEEP_CURRENT_UA    (18U)
+
+/* Default per-widget scan and processing durations in microseconds. The skip
+ * time is the CPU time of a scan whose processing is skipped: the raw count
+ * check of the ganged fast path or of the scan ISR, and the difference count
+ * update. FAST_SLIDER_PROCESS_TIME_US is the processing time of the slider
+ * with FAST_SLIDER_ENABLE.
+ */
+#define ENERGY_MODEL_SLIDER_SCAN_TIME_US     (2000U)
+#define ENERGY_MODEL_SLIDER_PROCESS_TIME_US  (1100U)
+#define ENERGY_MODEL_FAST_SLIDER_PROCESS_TIME_US (400U)
+#define ENERGY_MODEL_SLIDER_SKIP_TIME_US     (60U)
+#define ENERGY_MODEL_GANGED_SCAN_TIME_US     (600U)
+#define ENERGY_MODEL_GANGED_PROCESS_TIME_US  (400U)
+#define ENERGY_MODEL_GANGED_SKIP_TIME_US     (20U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Per-widget duration coefficients. */
+typedef struct
+{
+    uint32_t scan_time_us;
+    uint32_t process_time_us;
+    uint32_t skip_time_us;
+} energy_model_widget_t;
+
+/* Energy model state. Charge is accumulated in pC (uA x us). */
+typedef struct
+{
+    const energy_model_widget_t *widgets;
+    uint32_t num_widgets;
+
+    uint64_t scan_charge_pc;
+    uint64_t process_charge_pc;
+    uint64_t deepsleep_charge_pc;
+    uint64_t total_time_us;
+} energy_model_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void energy_model_init(energy_model_t *model, const energy_model_widget_t *widgets,
+                       uint32_t num_widgets);
+void energy_model_record_scan(energy_model_t *model, uint32_t widget_id,
+                              bool is_skipped, uint32_t interval_ms);
+void energy_model_record_batch(energy_model_t *model, const uint32_t *widget_ids,
+                               uint32_t num_widgets, uint32_t skipped_mask,
+                               uint32_t interval_ms);
+void energy_model_record_period(energy_model_t *model, uint32_t scan_time_us,
+                                uint32_t process_time_us, uint32_t period_us);
+uint32_t energy_model_get_average_current_na(const energy_model_t *model);
+
+
+#endif /* SOURCE_ENERGY_MODEL_H */
+
+/* [] END OF FILE */
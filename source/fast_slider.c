@@ -0,0 +1,311 @@
+/******************************************************************************
+* File Name:   fast_slider.c
+*
+* Description: This file contains function definitions of the fixed-point slider
+*              filter and centroid kernels. The centroid uses a reciprocal table
+*              instead of a division and, on cores with the DSP extension, SMLAD
+*              to accumulate two sensors per instruction.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "fast_slider.h"
+
+#include <string.h>
+
+#if (defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+#include "cmsis_compiler.h"
+#define FAST_SLIDER_USE_SMLAD
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The reciprocal table holds 2^22 / m for the normalized mantissas m in
+ * [128, 255], i.e. 8 significant bits of the denominator.
+ */
+#define RECIPROCAL_MANTISSA_BITS             (8U)
+#define RECIPROCAL_SHIFT                     (15U)
+
+#if ((FAST_SLIDER_MAX_SENSORS % 2U) != 0U)
+#error "FAST_SLIDER_MAX_SENSORS must be even."
+#endif
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static const uint16_t reciprocal_table[1U << (RECIPROCAL_MANTISSA_BITS - 1U)] =
+{
+    32768U, 32514U, 32264U, 32018U, 31775U, 31536U, 31301U, 31069U,
+    30840U, 30615U, 30394U, 30175U, 29959U, 29747U, 29537U, 29331U,
+    29127U, 28926U, 28728U, 28533U, 28340U, 28150U, 27962U, 27777U,
+    27594U, 27414U, 27236U, 27060U, 26887U, 26715U, 26546U, 26379U,
+    26214U, 26052U, 25891U, 25732U, 25575U, 25420U, 25267U, 25116U,
+    24966U, 24818U, 24672U, 24528U, 24385U, 24245U, 24105U, 23967U,
+    23831U, 23697U, 23564U, 23432U, 23302U, 23173U, 23046U, 22920U,
+    22795U, 22672U, 22550U, 22429U, 22310U, 22192U, 22075U, 21960U,
+    21845U, 21732U, 21620U, 21509U, 21400U, 21291U, 21183U, 21077U,
+    20972U, 20867U, 20764U, 20662U, 20560U, 20460U, 20361U, 20262U,
+    20165U, 20068U, 19973U, 19878U, 19784U, 19692U, 19600U, 19508U,
+    19418U, 19329U, 19240U, 19152U, 19065U, 18979U, 18893U, 18809U,
+    18725U, 18641U, 18559U, 18477U, 18396U, 18316U, 18236U, 18157U,
+    18079U, 18001U, 17924U, 17848U, 17772U, 17697U, 17623U, 17549U,
+    17476U, 17404U, 17332U, 17261U, 17190U, 17120U, 17050U, 16981U,
+    16913U, 16845U, 16777U, 16710U, 16644U, 16578U, 16513U, 16448U
+};
+
+#if (defined(FAST_SLIDER_USE_SMLAD))
+/* Sensor weights of the first moment, packed in pairs for SMLAD. */
+static const uint32_t moment_weights[FAST_SLIDER_MAX_SENSORS / 2U] =
+{
+    0x00010000U, 0x00030002U, 0x00050004U, 0x00070006U
+};
+#endif /* FAST_SLIDER_USE_SMLAD */
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static uint16_t median3(uint16_t a, uint16_t b, uint16_t c);
+static uint32_t scale_by_reciprocal(uint32_t numerator, uint32_t denominator);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: fast_slider_init
+********************************************************************************
+* Summary: Initializes the slider state. The filter is primed with the first
+* raw counts passed to fast_slider_filter.
+*
+*******************************************************************************/
+void fast_slider_init(fast_slider_t *slider, const fast_slider_config_t *config)
+{
+    memset(slider, 0, sizeof(*slider));
+    slider->config = *config;
+
+    if (slider->config.num_sensors > FAST_SLIDER_MAX_SENSORS)
+    {
+        slider->config.num_sensors = FAST_SLIDER_MAX_SENSORS;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: fast_slider_filter
+********************************************************************************
+* Summary: Filters the raw counts of all sensors in place with a 3-sample
+* median filter followed by a fixed-point IIR filter.
+*
+* Parameters:
+* fast_slider_t *slider: Slider state.
+* uint16_t *raw: Raw counts of the sensors, in sensor order.
+*
+*******************************************************************************/
+void fast_slider_filter(fast_slider_t *slider, uint16_t *raw)
+{
+    uint16_t median;
+    int32_t sample;
+
+    for (uint32_t i = 0; i < slider->config.num_sensors; i++)
+    {
+        if (!slider->is_filter_initialized)
+        {
+            slider->median_history[i][0] = raw[i];
+            slider->median_history[i][1] = raw[i];
+            slider->iir_state[i] = (int32_t)raw[i] << FAST_SLIDER_IIR_FRACTION_BITS;
+        }
+
+        median = median3(slider->median_history[i][0], slider->median_history[i][1], raw[i]);
+        slider->median_history[i][0] = slider->median_history[i][1];
+        slider->median_history[i][1] = raw[i];
+
+        sample = (int32_t)median << FAST_SLIDER_IIR_FRACTION_BITS;
+        slider->iir_state[i] += (sample - slider->iir_state[i]) >> FAST_SLIDER_IIR_SHIFT;
+
+        raw[i] = (uint16_t)((slider->iir_state[i] + (1 << (FAST_SLIDER_IIR_FRACTION_BITS - 1U))) >>
+                            FAST_SLIDER_IIR_FRACTION_BITS);
+    }
+
+    slider->is_filter_initialized = true;
+}
+
+
+/*******************************************************************************
+* Function Name: fast_slider_get_position
+********************************************************************************
+* Summary: Detects a touch on the slider with hysteresis and computes the
+* centroid of the difference counts above the noise threshold.
+*
+* Parameters:
+* fast_slider_t *slider: Slider state.
+* const uint16_t *diff: Difference counts of the sensors, in sensor order.
+* uint16_t *position: Returns the position in [0, resolution] if touched.
+*
+* Return:
+* bool: Whether the slider is touched.
+*
+*******************************************************************************/
+bool fast_slider_get_position(fast_slider_t *slider, const uint16_t *diff,
+                              uint16_t *position)
+{
+    const fast_slider_config_t *config = &slider->config;
+    uint16_t signal[FAST_SLIDER_MAX_SENSORS] = { 0U };
+    uint16_t max_diff = 0U;
+    uint32_t sum = 0U;
+    uint32_t moment = 0U;
+    uint32_t value;
+
+    for (uint32_t i = 0; i < config->num_sensors; i++)
+    {
+        if (diff[i] > max_diff)
+        {
+            max_diff = diff[i];
+        }
+
+        /* Signed halfwords are accumulated by SMLAD, keep them positive. */
+        value = (diff[i] > config->noise_th) ? (uint32_t)(diff[i] - config->noise_th) : 0U;
+        signal[i] = (uint16_t)((value > (uint32_t)INT16_MAX) ? (uint32_t)INT16_MAX : value);
+    }
+
+    if (slider->is_touched)
+    {
+        slider->is_touched = (((uint32_t)max_diff + config->hysteresis) >= config->finger_th);
+    }
+    else
+    {
+        slider->is_touched = ((uint32_t)max_diff > (uint32_t)config->finger_th + config->hysteresis);
+    }
+
+    if (!slider->is_touched)
+    {
+        return false;
+    }
+
+#if (defined(FAST_SLIDER_USE_SMLAD))
+    for (uint32_t i = 0; i < config->num_sensors; i += 2U)
+    {
+        uint32_t pair;
+
+        memcpy(&pair, &signal[i], sizeof(pair));
+        moment = __SMLAD(pair, moment_weights[i / 2U], moment);
+        sum = __SMLAD(pair, 0x00010001U, sum);
+    }
+#else
+    for (uint32_t i = 0; i < config->num_sensors; i++)
+    {
+        moment += i * signal[i];
+        sum += signal[i];
+    }
+#endif /* FAST_SLIDER_USE_SMLAD */
+
+    if ((0U == sum) || (config->num_sensors < 2U))
+    {
+        return false;
+    }
+
+    /* position = moment * resolution / (sum * (num_sensors - 1)) */
+    value = scale_by_reciprocal(moment * config->resolution, sum * (config->num_sensors - 1U));
+    *position = (uint16_t)((value > config->resolution) ? config->resolution : value);
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: median3
+********************************************************************************
+* Summary: Returns the median of three values.
+*
+*******************************************************************************/
+static uint16_t median3(uint16_t a, uint16_t b, uint16_t c)
+{
+    if (a > b)
+    {
+        uint16_t temp = a;
+        a = b;
+        b = temp;
+    }
+
+    /* a <= b */
+    return (c <= a) ? a : ((c >= b) ? b : c);
+}
+
+
+/*******************************************************************************
+* Function Name: scale_by_reciprocal
+********************************************************************************
+* Summary: Returns numerator / denominator, rounded, computed with the
+* reciprocal table. The relative error is below 2^-8.
+*
+*******************************************************************************/
+static uint32_t scale_by_reciprocal(uint32_t numerator, uint32_t denominator)
+{
+    uint32_t msb = 31U - (uint32_t)__builtin_clz(denominator);
+    uint32_t mantissa;
+
+    /* Normalize the denominator to RECIPROCAL_MANTISSA_BITS bits. */
+    if (msb >= (RECIPROCAL_MANTISSA_BITS - 1U))
+    {
+        uint32_t shift = msb - (RECIPROCAL_MANTISSA_BITS - 1U);
+
+        mantissa = (shift > 0U) ? ((denominator + (1UL << (shift - 1U))) >> shift) : denominator;
+        if (mantissa >= (1UL << RECIPROCAL_MANTISSA_BITS))
+        {
+            /* Rounding carried into the next bit. */
+            mantissa >>= 1;
+            msb++;
+        }
+    }
+    else
+    {
+        mantissa = denominator << ((RECIPROCAL_MANTISSA_BITS - 1U) - msb);
+    }
+
+    /* 1 / denominator = reciprocal_table[] * 2^-(msb + RECIPROCAL_SHIFT) */
+    return (uint32_t)((((uint64_t)numerator * reciprocal_table[mantissa - (1UL << (RECIPROCAL_MANTISSA_BITS - 1U))]) +
+                       (1ULL << (msb + RECIPROCAL_SHIFT - 1U))) >> (msb + RECIPROCAL_SHIFT));
+}
+
+
+/* [] END OF FILE */
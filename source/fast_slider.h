@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name:   fast_slider.h
+*
+* Description: This file contains macros, data types and function prototypes of
+*              the fixed-point slider filter and centroid kernels.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_FAST_SLIDER_H
+#define SOURCE_FAST_SLIDER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of sensors of the slider. Must be even. */
+#define FAST_SLIDER_MAX_SENSORS              (8U)
+
+/* The raw counts are filtered by a 3-sample median followed by a first-order
+ * IIR filter with a coefficient of 2^-FAST_SLIDER_IIR_SHIFT. The IIR state is
+ * kept with FAST_SLIDER_IIR_FRACTION_BITS fractional bits.
+ */
+#define FAST_SLIDER_IIR_SHIFT                (2U)
+#define FAST_SLIDER_IIR_FRACTION_BITS        (4U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Slider parameters, usually taken from the CapSense configuration. */
+typedef struct
+{
+    uint32_t num_sensors;
+    uint32_t resolution;
+    uint16_t finger_th;
+    uint16_t hysteresis;
+    uint16_t noise_th;
+} fast_slider_config_t;
+
+typedef struct
+{
+    fast_slider_config_t config;
+    uint16_t median_history[FAST_SLIDER_MAX_SENSORS][2];
+    int32_t iir_state[FAST_SLIDER_MAX_SENSORS];
+    bool is_filter_initialized;
+    bool is_touched;
+} fast_slider_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void fast_slider_init(fast_slider_t *slider, const fast_slider_config_t *config);
+void fast_slider_filter(fast_slider_t *slider, uint16_t *raw);
+bool fast_slider_get_position(fast_slider_t *slider, const uint16_t *diff,
+                              uint16_t *position);
+
+
+#endif /* SOURCE_FAST_SLIDER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,290 @@
+/******************************************************************************
+* File Name:   gesture.c
+*
+* Description: This file contains function definitions of the slider gesture
+*              recognizer. The recognizer is fed with the slider touch state and
+*              position of every scan and turns them into tap, double tap, long
+*              press, swipe and flick events.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "gesture.h"
+
+#include <stddef.h>
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static uint32_t get_distance(uint16_t from, uint16_t to);
+static bool is_double_tap_possible(const gesture_t *gesture, bool is_touched, uint16_t position,
+                                   uint32_t now_ms);
+static void add_event(gesture_event_t *events, uint32_t *num_events, gesture_type_t type,
+                      uint16_t position, int32_t velocity);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: gesture_init
+********************************************************************************
+* Summary: Initializes the recognizer with no touch.
+*
+*******************************************************************************/
+void gesture_init(gesture_t *gesture)
+{
+    gesture->is_touched = false;
+    gesture->is_long_press_reported = false;
+    gesture->start_position = 0;
+    gesture->last_position = 0;
+    gesture->start_ms = 0;
+    gesture->last_ms = 0;
+    gesture->last_tap_ms = 0;
+    gesture->last_tap_position = 0;
+    gesture->has_pending_tap = false;
+}
+
+
+/*******************************************************************************
+* Function Name: gesture_update
+********************************************************************************
+* Summary: Feeds the result of one slider scan into the recognizer.
+*
+* A long press is reported while the finger is still on the slider. All other
+* gestures are reported when the finger is lifted. A tap is held back until
+* GESTURE_DOUBLE_TAP_MAX_GAP_MS has passed without a second tap, or until the
+* next touch can no longer be a tap; a second tap within that time is reported
+* as a single double tap instead. A tap is therefore reported up to
+* GESTURE_DOUBLE_TAP_MAX_GAP_MS after the finger is lifted, at the first update
+* after the gap, and consumers never see the tap of a double tap.
+*
+* Parameters:
+* gesture_t *gesture: Pointer to the recognizer state.
+* bool is_touched: Whether the slider is touched.
+* uint16_t position: Slider position. Ignored if is_touched is false.
+* uint32_t now_ms: Time of the scan.
+* gesture_event_t events[]: Recognized gestures, in the order they occurred.
+*
+* Return:
+* uint32_t: Number of gestures in events.
+*
+*******************************************************************************/
+uint32_t gesture_update(gesture_t *gesture, bool is_touched, uint16_t position,
+                        uint32_t now_ms, gesture_event_t events[GESTURE_MAX_EVENTS])
+{
+    uint32_t num_events = 0;
+    uint32_t duration_ms;
+    uint32_t distance;
+    int32_t displacement;
+    int32_t velocity;
+
+    /* Report the held-back tap as soon as the sample rules out a double tap. */
+    if (gesture->has_pending_tap &&
+        !is_double_tap_possible(gesture, is_touched, position, now_ms))
+    {
+        gesture->has_pending_tap = false;
+        add_event(events, &num_events, GESTURE_TAP, gesture->last_tap_position, 0);
+    }
+
+    if (is_touched)
+    {
+        if (!gesture->is_touched)
+        {
+            /* Touch down */
+            gesture->is_touched = true;
+            gesture->is_long_press_reported = false;
+            gesture->start_position = position;
+            gesture->start_ms = now_ms;
+        }
+        else if ((!gesture->is_long_press_reported) &&
+                 ((now_ms - gesture->start_ms) >= GESTURE_LONG_PRESS_MIN_DURATION_MS) &&
+                 (get_distance(gesture->start_position, position) <= GESTURE_TAP_MAX_DISTANCE))
+        {
+            gesture->is_long_press_reported = true;
+            add_event(events, &num_events, GESTURE_LONG_PRESS, position, 0);
+        }
+        else
+        {
+            /* Touch is moving or held. */
+        }
+
+        gesture->last_position = position;
+        gesture->last_ms = now_ms;
+    }
+    else if (gesture->is_touched)
+    {
+        /* Lift-off: classify the touch from its start and last samples. */
+        gesture->is_touched = false;
+        duration_ms = gesture->last_ms - gesture->start_ms;
+        distance = get_distance(gesture->start_position, gesture->last_position);
+        displacement = (int32_t)gesture->last_position - (int32_t)gesture->start_position;
+
+        if (gesture->is_long_press_reported)
+        {
+            /* Already reported while the finger was down. */
+        }
+        else if ((distance <= GESTURE_TAP_MAX_DISTANCE) &&
+                 (duration_ms <= GESTURE_TAP_MAX_DURATION_MS))
+        {
+            if (gesture->has_pending_tap)
+            {
+                gesture->has_pending_tap = false;
+                add_event(events, &num_events, GESTURE_DOUBLE_TAP, gesture->last_position, 0);
+            }
+            else
+            {
+                gesture->has_pending_tap = true;
+                gesture->last_tap_ms = gesture->last_ms;
+                gesture->last_tap_position = gesture->last_position;
+            }
+        }
+        else if (distance >= GESTURE_SWIPE_MIN_DISTANCE)
+        {
+            /* A swipe seen in a single scan has no measurable duration. */
+            velocity = (displacement * 1000) / (int32_t)((0U != duration_ms) ? duration_ms : 1U);
+
+            if ((duration_ms <= GESTURE_FLICK_MAX_DURATION_MS) &&
+                ((uint32_t)((velocity < 0) ? -velocity : velocity) >= GESTURE_FLICK_MIN_VELOCITY))
+            {
+                add_event(events, &num_events, GESTURE_FLICK, gesture->last_position, velocity);
+            }
+            else
+            {
+                add_event(events, &num_events, GESTURE_SWIPE, gesture->last_position, velocity);
+            }
+        }
+        else
+        {
+            /* Neither a tap nor a swipe. */
+        }
+    }
+    else
+    {
+        /* No touch. */
+    }
+
+    return num_events;
+}
+
+
+/*******************************************************************************
+* Function Name: gesture_get_name
+********************************************************************************
+* Summary: Returns a printable name of the gesture type.
+*
+*******************************************************************************/
+const char *gesture_get_name(gesture_type_t type)
+{
+    static const char *const gesture_names[] =
+    {
+        [GESTURE_NONE]          = "none",
+        [GESTURE_TAP]           = "tap",
+        [GESTURE_DOUBLE_TAP]    = "double tap",
+        [GESTURE_LONG_PRESS]    = "long press",
+        [GESTURE_SWIPE]         = "swipe",
+        [GESTURE_FLICK]         = "flick"
+    };
+
+    return ((uint32_t)type < (sizeof(gesture_names) / sizeof(gesture_names[0]))) ?
+           gesture_names[type] : NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: get_distance
+********************************************************************************
+* Summary: Returns the absolute distance between two slider positions.
+*
+*******************************************************************************/
+static uint32_t get_distance(uint16_t from, uint16_t to)
+{
+    return (from > to) ? (uint32_t)(from - to) : (uint32_t)(to - from);
+}
+
+
+/*******************************************************************************
+* Function Name: is_double_tap_possible
+********************************************************************************
+* Summary: Returns whether the pending tap can still become a double tap with
+* the sample. Without a touch in progress, a second tap must start within
+* GESTURE_DOUBLE_TAP_MAX_GAP_MS. A touch in progress started within the gap
+* (it was checked at touch down) and must still be a tap: within
+* GESTURE_TAP_MAX_DURATION_MS and GESTURE_TAP_MAX_DISTANCE of its start. At
+* lift-off, the last touched sample decides.
+*
+*******************************************************************************/
+static bool is_double_tap_possible(const gesture_t *gesture, bool is_touched, uint16_t position,
+                                   uint32_t now_ms)
+{
+    if (!gesture->is_touched)
+    {
+        return ((now_ms - gesture->last_tap_ms) <= GESTURE_DOUBLE_TAP_MAX_GAP_MS);
+    }
+
+    if (!is_touched)
+    {
+        position = gesture->last_position;
+        now_ms = gesture->last_ms;
+    }
+
+    return ((now_ms - gesture->start_ms) <= GESTURE_TAP_MAX_DURATION_MS) &&
+           (get_distance(gesture->start_position, position) <= GESTURE_TAP_MAX_DISTANCE);
+}
+
+
+/*******************************************************************************
+* Function Name: add_event
+*******************************************************************************/
+static void add_event(gesture_event_t *events, uint32_t *num_events, gesture_type_t type,
+                      uint16_t position, int32_t velocity)
+{
+    if (GESTURE_MAX_EVENTS > *num_events)
+    {
+        events[*num_events].type = type;
+        events[*num_events].position = position;
+        events[*num_events].velocity = velocity;
+        (*num_events)++;
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,131 @@
+/******************************************************************************
+* File Name:   gesture.h
+*
+* Description: This file contains macros, data types and function prototypes of
+*              the slider gesture recognizer.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_GESTURE_H
+#define SOURCE_GESTURE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+/* The gesture recognizer does not depend on the PDL, HAL, CapSense middleware
+ * or FreeRTOS, in the same way as the scan policy.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The distance thresholds are in slider position units. The defaults assume
+ * the slider resolution of 0 to 100 configured in design.cycapsense.
+ */
+#define GESTURE_TAP_MAX_DURATION_MS          (250U)
+#define GESTURE_TAP_MAX_DISTANCE             (8U)
+#define GESTURE_DOUBLE_TAP_MAX_GAP_MS        (300U)
+#define GESTURE_LONG_PRESS_MIN_DURATION_MS   (800U)
+#define GESTURE_SWIPE_MIN_DISTANCE           (20U)
+
+/* A swipe shorter than GESTURE_FLICK_MAX_DURATION_MS that is faster than
+ * GESTURE_FLICK_MIN_VELOCITY (position units per second) is a flick.
+ */
+#define GESTURE_FLICK_MAX_DURATION_MS        (300U)
+#define GESTURE_FLICK_MIN_VELOCITY           (200U)
+
+/* Maximum number of gestures reported by one update: a held-back tap that
+ * turns out not to be the first half of a double tap, and a new gesture.
+ */
+#define GESTURE_MAX_EVENTS                   (2U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    GESTURE_NONE,
+    GESTURE_TAP,
+    GESTURE_DOUBLE_TAP,
+    GESTURE_LONG_PRESS,
+    GESTURE_SWIPE,
+    GESTURE_FLICK
+} gesture_type_t;
+
+/* Recognized gesture. velocity is signed: positive values are towards higher
+ * slider positions. It is 0 for taps and long presses.
+ */
+typedef struct
+{
+    gesture_type_t type;
+    uint16_t position;
+    int32_t velocity;
+} gesture_event_t;
+
+/* Recognizer state. The memory use is constant regardless of the length of the
+ * touch.
+ */
+typedef struct
+{
+    bool is_touched;
+    bool is_long_press_reported;
+    uint16_t start_position;
+    uint16_t last_position;
+    uint32_t start_ms;
+    uint32_t last_ms;
+    uint32_t last_tap_ms;
+    uint16_t last_tap_position;
+    bool has_pending_tap;
+} gesture_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void gesture_init(gesture_t *gesture);
+uint32_t gesture_update(gesture_t *gesture, bool is_touched, uint16_t position,
+                        uint32_t now_ms, gesture_event_t events[GESTURE_MAX_EVENTS]);
+const char *gesture_get_name(gesture_type_t type);
+
+
+#endif /* SOURCE_GESTURE_H */
+
+/* [] END OF FILE */
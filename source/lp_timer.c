@@ -0,0 +1,234 @@
+/******************************************************************************
+* File Name:   lp_timer.c
+*
+* Description: This file contains function definitions of the deep-sleep-capable
+*              low-power timer. The timer provides a free-running time base and
+*              a periodic interrupt that can wake the device from deep sleep.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cyhal.h"
+#include "cy_pdl.h"
+
+#include "lp_timer.h"
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static cyhal_lptimer_t lp_timer_obj;
+static bool lp_timer_is_initialized = false;
+
+static lp_timer_callback_t lp_timer_callback;
+static volatile uint32_t lp_timer_period_ticks;
+static volatile uint32_t lp_timer_next_match;
+
+/* Largest observed delay between the match value and the start of the
+ * interrupt handler.
+ */
+static volatile uint32_t lp_timer_max_latency_ticks;
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void lp_timer_isr(void *callback_arg, cyhal_lptimer_event_t event);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: lp_timer_init
+********************************************************************************
+* Summary: Initializes the LPTimer. The function can be called more than once;
+* only the first call initializes the hardware.
+*
+* Return:
+* cy_rslt_t: Result of the LPTimer initialization.
+*
+*******************************************************************************/
+cy_rslt_t lp_timer_init(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (!lp_timer_is_initialized)
+    {
+        result = cyhal_lptimer_init(&lp_timer_obj);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            cyhal_lptimer_register_callback(&lp_timer_obj, lp_timer_isr, NULL);
+            lp_timer_is_initialized = true;
+        }
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: lp_timer_read
+********************************************************************************
+* Summary: Returns the free-running LPTimer count in LP_TIMER_FREQ_HZ ticks.
+*
+*******************************************************************************/
+uint32_t lp_timer_read(void)
+{
+    return cyhal_lptimer_read(&lp_timer_obj);
+}
+
+
+/*******************************************************************************
+* Function Name: lp_timer_start_periodic
+********************************************************************************
+* Summary: Starts calling callback every period_ms from the LPTimer interrupt.
+* Each match is scheduled relative to the previous match rather than to the
+* interrupt, so that the interrupt latency does not accumulate.
+*
+* Parameters:
+* uint32_t period_ms: Period of the callback.
+* lp_timer_callback_t callback: Function called from the LPTimer interrupt.
+*
+*******************************************************************************/
+void lp_timer_start_periodic(uint32_t period_ms, lp_timer_callback_t callback)
+{
+    lp_timer_callback = callback;
+    lp_timer_period_ticks = LP_TIMER_MS_TO_TICKS(period_ms);
+    lp_timer_next_match = lp_timer_read() + lp_timer_period_ticks;
+
+    cyhal_lptimer_set_match(&lp_timer_obj, lp_timer_next_match);
+    cyhal_lptimer_enable_event(&lp_timer_obj, CYHAL_LPTIMER_COMPARE_MATCH,
+                               LP_TIMER_INTR_PRIORITY, true);
+}
+
+
+/*******************************************************************************
+* Function Name: lp_timer_change_period
+********************************************************************************
+* Summary: Changes the period of the periodic callback. Same as
+* xTimerChangePeriod, the new period starts from the time of the call.
+*
+*******************************************************************************/
+void lp_timer_change_period(uint32_t period_ms)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    lp_timer_period_ticks = LP_TIMER_MS_TO_TICKS(period_ms);
+    lp_timer_next_match = lp_timer_read() + lp_timer_period_ticks;
+    cyhal_lptimer_set_match(&lp_timer_obj, lp_timer_next_match);
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*******************************************************************************
+* Function Name: lp_timer_get_max_latency_ticks
+********************************************************************************
+* Summary: Returns the largest observed delay between a match and its
+* interrupt, i.e. the trigger jitter of the periodic callback.
+*
+*******************************************************************************/
+uint32_t lp_timer_get_max_latency_ticks(void)
+{
+    return lp_timer_max_latency_ticks;
+}
+
+
+/*******************************************************************************
+* Function Name: lp_timer_get_ticks_to_match
+********************************************************************************
+* Summary: Returns the LPTimer ticks to the next periodic match and the period.
+*
+* Return:
+*  bool: false if the periodic callback is not started.
+*
+*******************************************************************************/
+bool lp_timer_get_ticks_to_match(uint32_t *ticks_to_match, uint32_t *period_ticks)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t ticks = lp_timer_next_match - lp_timer_read();
+    uint32_t period = lp_timer_period_ticks;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    /* The match has passed and the interrupt is pending. */
+    if (ticks > period)
+    {
+        ticks = 0U;
+    }
+
+    *ticks_to_match = ticks;
+    *period_ticks = period;
+
+    return (NULL != lp_timer_callback);
+}
+
+
+/*******************************************************************************
+* Function Name: lp_timer_isr
+********************************************************************************
+* Summary: LPTimer interrupt handler. Schedules the next match and calls the
+* periodic callback.
+*
+*******************************************************************************/
+static void lp_timer_isr(void *callback_arg, cyhal_lptimer_event_t event)
+{
+    uint32_t latency_ticks = lp_timer_read() - lp_timer_next_match;
+
+    (void)callback_arg;
+    (void)event;
+
+    if (latency_ticks > lp_timer_max_latency_ticks)
+    {
+        lp_timer_max_latency_ticks = latency_ticks;
+    }
+
+    lp_timer_next_match += lp_timer_period_ticks;
+    cyhal_lptimer_set_match(&lp_timer_obj, lp_timer_next_match);
+
+    if (NULL != lp_timer_callback)
+    {
+        lp_timer_callback();
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name:   lp_timer.h
+*
+* Description: This file contains macros and function prototypes of the
+*              deep-sleep-capable low-power timer used by the example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_LP_TIMER_H
+#define SOURCE_LP_TIMER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cyhal.h"
+#include "cycfg.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The LPTimer (MCWDT) counts CLK_LF, which keeps running in system deep sleep. */
+#define LP_TIMER_FREQ_HZ                (CY_CFG_SYSCLK_CLKLF_FREQ_HZ)
+#define LP_TIMER_MS_TO_TICKS(ms)        ((uint32_t)(((uint64_t)(ms) * LP_TIMER_FREQ_HZ) / 1000U))
+#define LP_TIMER_TICKS_TO_US(ticks)     ((uint32_t)(((uint64_t)(ticks) * 1000000U) / LP_TIMER_FREQ_HZ))
+
+/* LPTimer interrupt priority. The callback calls FreeRTOS FromISR APIs, so the
+ * priority must not be higher than configMAX_API_CALL_INTERRUPT_PRIORITY.
+ */
+#define LP_TIMER_INTR_PRIORITY          (6u)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Periodic callback. Called from the LPTimer interrupt. */
+typedef void (*lp_timer_callback_t)(void);
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t lp_timer_init(void);
+uint32_t lp_timer_read(void);
+void lp_timer_start_periodic(uint32_t period_ms, lp_timer_callback_t callback);
+void lp_timer_change_period(uint32_t period_ms);
+uint32_t lp_timer_get_max_latency_ticks(void);
+bool lp_timer_get_ticks_to_match(uint32_t *ticks_to_match, uint32_t *period_ticks);
+
+
+#endif /* SOURCE_LP_TIMER_H */
+
+/* [] END OF FILE */
@@ -49,6 +49,10 @@
 #include "task.h"
 
 #include "capsense.h"
+#include "touch_event.h"
+#if (defined(UART_TX_DMA_ENABLE))
+#include "uart_tx.h"
+#endif /* UART_TX_DMA_ENABLE */
 #include "low_power_config.h"
 
 
@@ -57,6 +61,16 @@
 ********************************************************************************/
 volatile int uxTopUsedPriority;
 
+#if (defined(STATIC_ALLOCATION_ONLY))
+/* Stacks and control blocks of the tasks. The stack sizes are given in words,
+ * like the stack depth passed to xTaskCreate.
+ */
+static StackType_t capsense_task_stack[CAPSENSE_TASK_STACK_SIZE_WORDS];
+static StaticTask_t capsense_task_tcb;
+static StackType_t touch_event_task_stack[TOUCH_EVENT_TASK_STACK_SIZE_WORDS];
+static StaticTask_t touch_event_task_tcb;
+#endif /* STATIC_ALLOCATION_ONLY */
+
 
 /*******************************************************************************
 * Function Name: main
@@ -105,9 +119,35 @@ int main(void)
            "PSoC 6 MCU: FreeRTOS Low-power CapSense Example\r\n "
            "*********************************************** \r\n\n");
 
+#if (defined(UART_TX_DMA_ENABLE))
+    /* Send the output of touch_event_task through DMA from now on */
+    if (CY_RSLT_SUCCESS != uart_tx_init())
+    {
+        CY_ASSERT(0);
+    }
+#endif /* UART_TX_DMA_ENABLE */
+
+#if (defined(STATIC_ALLOCATION_ONLY))
+    /* Create the CapSense task */
+    capsense_task_handle = xTaskCreateStatic(capsense_task, "CapSense Task",
+                                             CAPSENSE_TASK_STACK_SIZE_WORDS, NULL,
+                                             CAPSENSE_TASK_PRIORITY, capsense_task_stack,
+                                             &capsense_task_tcb);
+
+    /* Create the task that prints the events posted by the CapSense task */
+    touch_event_task_handle = xTaskCreateStatic(touch_event_task, "Touch Event Task",
+                                                TOUCH_EVENT_TASK_STACK_SIZE_WORDS, NULL,
+                                                TOUCH_EVENT_TASK_PRIORITY, touch_event_task_stack,
+                                                &touch_event_task_tcb);
+#else
     /* Create the CapSense task */
-    xTaskCreate(capsense_task, "CapSense Task", CAPSENSE_TASK_STACK_SIZE_BYTES,
+    xTaskCreate(capsense_task, "CapSense Task", CAPSENSE_TASK_STACK_SIZE_WORDS,
                 NULL, CAPSENSE_TASK_PRIORITY, &capsense_task_handle);
+
+    /* Create the task that prints the events posted by the CapSense task */
+    xTaskCreate(touch_event_task, "Touch Event Task", TOUCH_EVENT_TASK_STACK_SIZE_WORDS,
+                NULL, TOUCH_EVENT_TASK_PRIORITY, &touch_event_task_handle);
+#endif /* STATIC_ALLOCATION_ONLY */
     
     /* Start the scheduler */
     vTaskStartScheduler();
@@ -0,0 +1,302 @@
+/******************************************************************************
+* File Name:   residency.c
+*
+* Description: This file contains function definitions of the power mode
+*              residency accounting. The time spent in CPU active, CPU sleep
+*              and system deep sleep is measured with the LPTimer, which keeps
+*              counting in deep sleep, and is attributed to the current FSM
+*              state of capsense_task and to the current widget.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+
+#include "residency.h"
+#include "lp_timer.h"
+
+#include <stdio.h>
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static uint64_t residency_state_ticks[RESIDENCY_MAX_STATES][RESIDENCY_NUM_MODES];
+static uint64_t residency_widget_ticks[RESIDENCY_MAX_WIDGETS][RESIDENCY_NUM_MODES];
+
+static uint32_t residency_last_timestamp;
+static residency_mode_t residency_mode = RESIDENCY_ACTIVE;
+static uint32_t residency_state;
+static uint32_t residency_widget_id;
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void account_elapsed_time(void);
+static cy_en_syspm_status_t residency_syspm_cb(cy_stc_syspm_callback_params_t *callback_params,
+                                               cy_en_syspm_callback_mode_t mode);
+
+/* SysPm callbacks that timestamp the CPU sleep and system deep sleep
+ * transitions. They are registered in addition to capsense_deep_sleep_cb. The
+ * context of each callback holds the mode entered by its transition.
+ */
+static residency_mode_t residency_sleep_mode = RESIDENCY_SLEEP;
+static residency_mode_t residency_deepsleep_mode = RESIDENCY_DEEPSLEEP;
+
+static cy_stc_syspm_callback_params_t residency_sleep_callback_params =
+{
+    .base       = NULL,
+    .context    = &residency_sleep_mode
+};
+
+static cy_stc_syspm_callback_params_t residency_deep_sleep_callback_params =
+{
+    .base       = NULL,
+    .context    = &residency_deepsleep_mode
+};
+
+static cy_stc_syspm_callback_t residency_sleep_cb =
+{
+    residency_syspm_cb,
+    CY_SYSPM_SLEEP,
+    0,
+    &residency_sleep_callback_params,
+    NULL,
+    NULL
+};
+
+static cy_stc_syspm_callback_t residency_deep_sleep_cb =
+{
+    residency_syspm_cb,
+    CY_SYSPM_DEEPSLEEP,
+    0,
+    &residency_deep_sleep_callback_params,
+    NULL,
+    NULL
+};
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: residency_init
+********************************************************************************
+* Summary: Initializes the LPTimer time base and registers the SysPm callbacks.
+*
+*******************************************************************************/
+void residency_init(void)
+{
+    if (CY_RSLT_SUCCESS != lp_timer_init())
+    {
+        CY_ASSERT(0);
+    }
+
+    residency_last_timestamp = lp_timer_read();
+
+    Cy_SysPm_RegisterCallback(&residency_sleep_cb);
+    Cy_SysPm_RegisterCallback(&residency_deep_sleep_cb);
+}
+
+
+/*******************************************************************************
+* Function Name: residency_set_state
+********************************************************************************
+* Summary: Attributes the time since the last call to the previous FSM state
+* and widget, and sets the new ones.
+*
+* Parameters:
+* uint32_t state: The current FSM state of capsense_task.
+* uint32_t widget_id: The widget of the current scan tier.
+*
+*******************************************************************************/
+void residency_set_state(uint32_t state, uint32_t widget_id)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    account_elapsed_time();
+    residency_state = state;
+    residency_widget_id = widget_id;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*******************************************************************************
+* Function Name: residency_get_state_time_us
+********************************************************************************
+* Summary: Returns the time spent in mode while capsense_task was in state.
+*
+*******************************************************************************/
+uint64_t residency_get_state_time_us(uint32_t state, residency_mode_t mode)
+{
+    return (RESIDENCY_MAX_STATES > state) ?
+           ((residency_state_ticks[state][mode] * 1000000U) / LP_TIMER_FREQ_HZ) : 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: residency_get_widget_time_us
+********************************************************************************
+* Summary: Returns the time spent in mode while widget_id was being scanned.
+*
+*******************************************************************************/
+uint64_t residency_get_widget_time_us(uint32_t widget_id, residency_mode_t mode)
+{
+    return (RESIDENCY_MAX_WIDGETS > widget_id) ?
+           ((residency_widget_ticks[widget_id][mode] * 1000000U) / LP_TIMER_FREQ_HZ) : 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: residency_print
+********************************************************************************
+* Summary: Prints the time spent in each power mode per FSM state and per widget
+* on the serial terminal, in milliseconds.
+*
+* Parameters:
+* const char *const *state_names: Names of the FSM states, indexed by state.
+* uint32_t num_states: Number of entries in state_names.
+*
+*******************************************************************************/
+void residency_print(const char *const *state_names, uint32_t num_states)
+{
+    uint64_t total_us = 0;
+    uint64_t deepsleep_us = 0;
+
+    residency_set_state(residency_state, residency_widget_id);
+
+    printf("Residency (ms)            active      sleep deep sleep\r\n");
+
+    for (uint32_t state = 0; (state < num_states) && (state < RESIDENCY_MAX_STATES); state++)
+    {
+        if (NULL == state_names[state])
+        {
+            continue;
+        }
+
+        printf("  %-20s %10lu %10lu %10lu\r\n", state_names[state],
+               (unsigned long)(residency_get_state_time_us(state, RESIDENCY_ACTIVE) / 1000U),
+               (unsigned long)(residency_get_state_time_us(state, RESIDENCY_SLEEP) / 1000U),
+               (unsigned long)(residency_get_state_time_us(state, RESIDENCY_DEEPSLEEP) / 1000U));
+
+        for (uint32_t mode = 0; mode < RESIDENCY_NUM_MODES; mode++)
+        {
+            total_us += residency_get_state_time_us(state, (residency_mode_t)mode);
+        }
+        deepsleep_us += residency_get_state_time_us(state, RESIDENCY_DEEPSLEEP);
+    }
+
+    for (uint32_t wd = 0; wd < RESIDENCY_MAX_WIDGETS; wd++)
+    {
+        printf("  widget %-13lu %10lu %10lu %10lu\r\n", (unsigned long)wd,
+               (unsigned long)(residency_get_widget_time_us(wd, RESIDENCY_ACTIVE) / 1000U),
+               (unsigned long)(residency_get_widget_time_us(wd, RESIDENCY_SLEEP) / 1000U),
+               (unsigned long)(residency_get_widget_time_us(wd, RESIDENCY_DEEPSLEEP) / 1000U));
+    }
+
+    if (0U != total_us)
+    {
+        printf("Deep sleep residency = %lu.%02lu %%\r\n",
+               (unsigned long)((deepsleep_us * 100U) / total_us),
+               (unsigned long)(((deepsleep_us * 10000U) / total_us) % 100U));
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: account_elapsed_time
+********************************************************************************
+* Summary: Attributes the time since the last timestamp to the current power
+* mode, FSM state and widget. Must be called with interrupts disabled.
+*
+*******************************************************************************/
+static void account_elapsed_time(void)
+{
+    uint32_t now = lp_timer_read();
+    uint32_t elapsed = now - residency_last_timestamp;
+
+    residency_last_timestamp = now;
+
+    if (RESIDENCY_MAX_STATES > residency_state)
+    {
+        residency_state_ticks[residency_state][residency_mode] += elapsed;
+    }
+
+    if (RESIDENCY_MAX_WIDGETS > residency_widget_id)
+    {
+        residency_widget_ticks[residency_widget_id][residency_mode] += elapsed;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: residency_syspm_cb
+********************************************************************************
+* Summary: SysPm callback for CPU sleep and system deep sleep. Accounts the time
+* before the transition as active time and the time until the wake-up as sleep
+* or deep sleep time. The callback never prevents a transition.
+*
+*******************************************************************************/
+static cy_en_syspm_status_t residency_syspm_cb(cy_stc_syspm_callback_params_t *callback_params,
+                                               cy_en_syspm_callback_mode_t mode)
+{
+    switch (mode)
+    {
+        case CY_SYSPM_BEFORE_TRANSITION:
+            account_elapsed_time();
+            residency_mode = *(residency_mode_t *)callback_params->context;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            account_elapsed_time();
+            residency_mode = RESIDENCY_ACTIVE;
+            break;
+
+        default:
+            break;
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+
+/* [] END OF FILE */
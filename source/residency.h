@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name:   residency.h
+*
+* Description: This file contains macros and function prototypes of the power
+*              mode residency accounting.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_RESIDENCY_H
+#define SOURCE_RESIDENCY_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of FSM states and widgets the time is attributed to. State
+ * and widget values outside of these ranges are not accounted.
+ */
+#define RESIDENCY_MAX_STATES            (8U)
+#define RESIDENCY_MAX_WIDGETS           (4U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    RESIDENCY_ACTIVE,
+    RESIDENCY_SLEEP,
+    RESIDENCY_DEEPSLEEP,
+    RESIDENCY_NUM_MODES
+} residency_mode_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void residency_init(void);
+void residency_set_state(uint32_t state, uint32_t widget_id);
+uint64_t residency_get_state_time_us(uint32_t state, residency_mode_t mode);
+uint64_t residency_get_widget_time_us(uint32_t widget_id, residency_mode_t mode);
+void residency_print(const char *const *state_names, uint32_t num_states);
+
+
+#endif /* SOURCE_RESIDENCY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,168 @@
+/******************************************************************************
+* File Name:   runtime_stats.c
+*
+* Description: This file contains function definitions of the FreeRTOS
+*              run-time statistics time base and of the periodic report of
+*              the CPU time of the tasks. The time base is the LPTimer, which
+*              keeps counting in system deep sleep, so the time spent in
+*              tickless deep sleep is attributed to the idle task instead of
+*              being lost as with SysTick.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+
+#include "runtime_stats.h"
+#include "lp_timer.h"
+#include "touch_event.h"
+#include "capsense.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+
+/* The task run time is maintained by the kernel only with
+ * configGENERATE_RUN_TIME_STATS, which FreeRTOSConfig.h sets for
+ * RUNTIME_STATS_ENABLE.
+ */
+#if (defined(RUNTIME_STATS_ENABLE))
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+/* LPTimer count at runtime_stats_init. */
+static uint32_t runtime_stats_start;
+
+/* Run-time counter value of the last report. */
+static uint32_t runtime_stats_last_report;
+
+/* Run time of every task at the last report, in LPTimer ticks. */
+static uint32_t runtime_stats_last_task_time[RUNTIME_STATS_NUM_TASKS];
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: runtime_stats_init
+********************************************************************************
+* Summary: Initializes the LPTimer as the run-time statistics time base. Called
+* by vTaskStartScheduler through portCONFIGURE_TIMER_FOR_RUN_TIME_STATS.
+*
+*******************************************************************************/
+void runtime_stats_init(void)
+{
+    if (CY_RSLT_SUCCESS != lp_timer_init())
+    {
+        CY_ASSERT(0);
+    }
+
+    runtime_stats_start = lp_timer_read();
+}
+
+
+/*******************************************************************************
+* Function Name: runtime_stats_get_counter
+********************************************************************************
+* Summary: Returns the run-time counter in LP_TIMER_FREQ_HZ ticks since the
+* scheduler was started. Called by the kernel through
+* portGET_RUN_TIME_COUNTER_VALUE at every context switch. The counter wraps
+* after about 36 hours with a 32768 Hz CLK_LF; the reports use differences
+* and are not affected.
+*
+*******************************************************************************/
+uint32_t runtime_stats_get_counter(void)
+{
+    return lp_timer_read() - runtime_stats_start;
+}
+
+
+/*******************************************************************************
+* Function Name: runtime_stats_report
+********************************************************************************
+* Summary: Posts a TOUCH_EVENT_RUN_TIME event with the CPU time of the
+* CapSense task, the touch event task, the timer daemon task, and the idle task
+* since the previous report, if RUNTIME_STATS_REPORT_INTERVAL_MS has elapsed.
+* Interrupt handlers are accounted to the task they interrupt, and the time in
+* CPU sleep and system deep sleep to the idle task.
+*
+*******************************************************************************/
+void runtime_stats_report(void)
+{
+    uint32_t now = runtime_stats_get_counter();
+    uint32_t elapsed = now - runtime_stats_last_report;
+    TaskHandle_t tasks[RUNTIME_STATS_NUM_TASKS];
+    TaskStatus_t status;
+    uint32_t task_time;
+
+    if (elapsed < LP_TIMER_MS_TO_TICKS(RUNTIME_STATS_REPORT_INTERVAL_MS))
+    {
+        return;
+    }
+
+    tasks[RUNTIME_STATS_CAPSENSE_TASK] = capsense_task_handle;
+    tasks[RUNTIME_STATS_TOUCH_EVENT_TASK] = touch_event_task_handle;
+    tasks[RUNTIME_STATS_TIMER_TASK] = xTimerGetTimerDaemonTaskHandle();
+    tasks[RUNTIME_STATS_IDLE_TASK] = xTaskGetIdleTaskHandle();
+
+    for (uint32_t i = 0U; i < (uint32_t)RUNTIME_STATS_NUM_TASKS; i++)
+    {
+        if (NULL == tasks[i])
+        {
+            continue;
+        }
+
+        /* Skip the stack and state lookups; only the run time is used. */
+        vTaskGetInfo(tasks[i], &status, pdFALSE, eRunning);
+        task_time = status.ulRunTimeCounter - runtime_stats_last_task_time[i];
+        runtime_stats_last_task_time[i] = status.ulRunTimeCounter;
+
+        touch_event_post(TOUCH_EVENT_RUN_TIME, (uint8_t)i,
+                         (uint16_t)(((uint64_t)task_time * 1000U) / elapsed),
+                         (int32_t)LP_TIMER_TICKS_TO_US(task_time));
+    }
+
+    runtime_stats_last_report = now;
+}
+#endif /* RUNTIME_STATS_ENABLE */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name:   runtime_stats.h
+*
+* Description: This file contains macros and function prototypes of the
+*              FreeRTOS run-time statistics time base and of the periodic
+*              report of the CPU time of the tasks.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_RUNTIME_STATS_H
+#define SOURCE_RUNTIME_STATS_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Minimum time between two reports of the CPU time of the tasks. The report
+ * is made from capsense_task after a scan, so the actual interval also
+ * depends on the scan interval.
+ */
+#define RUNTIME_STATS_REPORT_INTERVAL_MS    (10000U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Tasks reported by TOUCH_EVENT_RUN_TIME. The first three values are the same
+ * as in touch_event_stack_task_t.
+ */
+typedef enum
+{
+    RUNTIME_STATS_CAPSENSE_TASK = 0,
+    RUNTIME_STATS_TOUCH_EVENT_TASK = 1,
+    RUNTIME_STATS_TIMER_TASK = 2,
+    RUNTIME_STATS_IDLE_TASK = 3,
+    RUNTIME_STATS_NUM_TASKS = 4
+} runtime_stats_task_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void runtime_stats_init(void);
+uint32_t runtime_stats_get_counter(void);
+void runtime_stats_report(void);
+
+
+#endif /* SOURCE_RUNTIME_STATS_H */
+
+/* [] END OF FILE */
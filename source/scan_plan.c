@@ -0,0 +1,200 @@
+/******************************************************************************
+* File Name:   scan_plan.c
+*
+* Description: This file contains function definitions of the scan plan. A batch
+*              starts with the first entry of the plan, and the end-of-scan
+*              interrupt chains the scans of the other entries due in the batch so
+*              that all of them are scanned in a single wake-up of capsense_task.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "scan_plan.h"
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: scan_plan_init
+********************************************************************************
+* Summary: Selects the plan to be executed. Every entry is due in the first
+* batch.
+*
+* Parameters:
+* scan_plan_t *plan: Scan plan state.
+* const scan_plan_config_t *config: Entries of the plan.
+*
+*******************************************************************************/
+void scan_plan_init(scan_plan_t *plan, const scan_plan_config_t *config)
+{
+    plan->entries = config->entries;
+    plan->num_entries = (config->num_entries > SCAN_PLAN_MAX_ENTRIES) ?
+                        SCAN_PLAN_MAX_ENTRIES : config->num_entries;
+    for (uint32_t i = 0; i < SCAN_PLAN_MAX_ENTRIES; i++)
+    {
+        plan->countdowns[i] = 0U;
+    }
+
+    /* Until a batch is started by the task, e.g. while the scans are started
+     * from the LPTimer interrupt, only the first entry is scanned.
+     */
+    plan->batch_mask = 1U;
+    plan->next_entry = plan->num_entries;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_plan_begin_batch
+********************************************************************************
+* Summary: Determines the entries due in the next batch.
+*
+* Return:
+* uint32_t: Widget of the first entry, which is scanned first.
+*
+*******************************************************************************/
+uint32_t scan_plan_begin_batch(scan_plan_t *plan)
+{
+    plan->batch_mask = 1U;
+
+    for (uint32_t i = 1; i < plan->num_entries; i++)
+    {
+        if (0U == plan->countdowns[i])
+        {
+            plan->batch_mask |= (1UL << i);
+        }
+    }
+
+    plan->next_entry = 1U;
+
+    return plan->entries[0].widget_id;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_plan_get_next
+********************************************************************************
+* Summary: Returns the next widget due in the current batch. Called from the
+* end-of-scan interrupt.
+*
+* Parameters:
+* scan_plan_t *plan: Scan plan state.
+* uint32_t *widget_id: Returns the widget to be scanned next.
+*
+* Return:
+* bool: false if all the widgets of the batch have been scanned.
+*
+*******************************************************************************/
+bool scan_plan_get_next(scan_plan_t *plan, uint32_t *widget_id)
+{
+    while (plan->next_entry < plan->num_entries)
+    {
+        uint32_t entry = plan->next_entry++;
+
+        if (0U != (plan->batch_mask & (1UL << entry)))
+        {
+            *widget_id = plan->entries[entry].widget_id;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_plan_get_batch
+********************************************************************************
+* Summary: Returns the widgets scanned in the current batch in plan order.
+*
+* Parameters:
+* const scan_plan_t *plan: Scan plan state.
+* uint32_t *widget_ids: Array of at least SCAN_PLAN_MAX_ENTRIES elements.
+*
+* Return:
+* uint32_t: Number of widgets.
+*
+*******************************************************************************/
+uint32_t scan_plan_get_batch(const scan_plan_t *plan, uint32_t *widget_ids)
+{
+    uint32_t num_widgets = 0;
+
+    for (uint32_t i = 0; i < plan->num_entries; i++)
+    {
+        if (0U != (plan->batch_mask & (1UL << i)))
+        {
+            widget_ids[num_widgets++] = plan->entries[i].widget_id;
+        }
+    }
+
+    return num_widgets;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_plan_end_batch
+********************************************************************************
+* Summary: Counts the batch once it has been processed. An entry that was
+* scanned is due again after divisor batches. A countdown rather than the
+* remainder of a batch counter keeps the spacing exact when the counter would
+* wrap around, for divisors that do not divide 2^32.
+*
+*******************************************************************************/
+void scan_plan_end_batch(scan_plan_t *plan)
+{
+    uint32_t divisor;
+
+    for (uint32_t i = 1; i < plan->num_entries; i++)
+    {
+        divisor = plan->entries[i].divisor;
+
+        if (0U != (plan->batch_mask & (1UL << i)))
+        {
+            plan->countdowns[i] = (divisor <= 1U) ? 0U : (divisor - 1U);
+        }
+        else if (0U != plan->countdowns[i])
+        {
+            plan->countdowns[i]--;
+        }
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name:   scan_plan.h
+*
+* Description: This file contains macros, data types and function prototypes of
+*              the scan plan, which describes the widgets scanned in a batch.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SCAN_PLAN_H
+#define SOURCE_SCAN_PLAN_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+/* Like the scan policy, the scan plan does not depend on the PDL, HAL,
+ * CapSense middleware or FreeRTOS.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of entries in a scan plan. */
+#define SCAN_PLAN_MAX_ENTRIES                (8U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Scan plan entry. The widget is scanned in every divisor-th batch. The first
+ * entry of a plan is scanned in every batch and its divisor is ignored.
+ */
+typedef struct
+{
+    uint32_t widget_id;
+    uint32_t divisor;
+} scan_plan_entry_t;
+
+/* Ordered list of the widgets scanned in a batch, i.e. in a single wake-up. */
+typedef struct
+{
+    const scan_plan_entry_t *entries;
+    uint32_t num_entries;
+} scan_plan_config_t;
+
+/* Scan plan state. countdowns holds the number of batches until each entry is
+ * due again, batch_mask the entries due in the current batch, and next_entry
+ * the entry to be checked next while the batch is scanned.
+ */
+typedef struct
+{
+    const scan_plan_entry_t *entries;
+    uint32_t num_entries;
+    uint32_t countdowns[SCAN_PLAN_MAX_ENTRIES];
+    uint32_t batch_mask;
+    uint32_t next_entry;
+} scan_plan_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void scan_plan_init(scan_plan_t *plan, const scan_plan_config_t *config);
+uint32_t scan_plan_begin_batch(scan_plan_t *plan);
+bool scan_plan_get_next(scan_plan_t *plan, uint32_t *widget_id);
+uint32_t scan_plan_get_batch(const scan_plan_t *plan, uint32_t *widget_ids);
+void scan_plan_end_batch(scan_plan_t *plan);
+
+
+#endif /* SOURCE_SCAN_PLAN_H */
+
+/* [] END OF FILE */
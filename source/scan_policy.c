@@ -0,0 +1,227 @@
+/******************************************************************************
+* File Name:   scan_policy.c
+*
+* Description: This file contains function definitions of the CapSense
+*              scan-rate policy. The policy decides which widget is scanned
+*              and how often, based on a table of scan-rate tiers and the
+*              touch detection result of the previous scan.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "scan_policy.h"
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: scan_policy_init
+********************************************************************************
+* Summary: Initializes the scan policy in the fastest tier and clears the
+* statistics.
+*
+* Parameters:
+* scan_policy_t *policy: Pointer to the scan policy state.
+* const scan_policy_tier_t *tiers: Tier table ordered from the fastest to the
+* slowest tier.
+* uint32_t num_tiers: Number of entries in the tier table. Must be between 1
+* and SCAN_POLICY_MAX_TIERS.
+*
+*******************************************************************************/
+void scan_policy_init(scan_policy_t *policy, const scan_policy_tier_t *tiers,
+                      uint32_t num_tiers)
+{
+    policy->tiers = tiers;
+    policy->num_tiers = (num_tiers > SCAN_POLICY_MAX_TIERS) ? SCAN_POLICY_MAX_TIERS : num_tiers;
+    policy->tier = 0;
+    policy->idle_scan_count = RESET_CAPSENSE_FAST_SCAN_COUNT;
+    policy->is_touch_expected = false;
+    policy->is_quiet_period = false;
+
+    for (uint32_t i = 0; i < SCAN_POLICY_MAX_TIERS; i++)
+    {
+        policy->scan_total[i] = 0;
+        policy->scan_time_ms[i] = 0;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: scan_policy_update
+********************************************************************************
+* Summary: Updates the scan policy with the touch detection result of the scan
+* that has just been processed.
+*
+* A touch detected in any tier resets the idle scan counter and moves the
+* policy to the fastest tier. If not, the idle scan counter is incremented
+* until max_idle_scans of the current tier after which the policy steps down
+* to the next slower tier.
+*
+* While the touch predictor expects a touch, the policy moves up to
+* SCAN_POLICY_PREWARM_TIER and does not step down below it. During usually
+* quiet periods, the policy steps down 2^SCAN_POLICY_QUIET_IDLE_SHIFT times
+* faster.
+*
+* Parameters:
+* scan_policy_t *policy: Pointer to the scan policy state.
+* bool is_touch_detected: Touch detection result of the last scan.
+*
+* Return:
+* scan_policy_transition_t: Tier transition the caller has to apply.
+*
+*******************************************************************************/
+scan_policy_transition_t scan_policy_update(scan_policy_t *policy,
+                                            bool is_touch_detected)
+{
+    scan_policy_transition_t transition = SCAN_POLICY_NO_CHANGE;
+    const scan_policy_tier_t *tier = &policy->tiers[policy->tier];
+    uint32_t prewarm_tier = (SCAN_POLICY_PREWARM_TIER < policy->num_tiers) ?
+                            SCAN_POLICY_PREWARM_TIER : (policy->num_tiers - 1U);
+    uint32_t max_idle_scans = tier->max_idle_scans;
+
+    policy->scan_total[policy->tier]++;
+    policy->scan_time_ms[policy->tier] += tier->interval_ms;
+
+    if (policy->is_quiet_period)
+    {
+        max_idle_scans >>= SCAN_POLICY_QUIET_IDLE_SHIFT;
+    }
+
+    if (is_touch_detected)
+    {
+        policy->idle_scan_count = RESET_CAPSENSE_FAST_SCAN_COUNT;
+
+        if (0U != policy->tier)
+        {
+            policy->tier = 0;
+            transition = SCAN_POLICY_WAKE_UP;
+        }
+    }
+    else if (policy->is_touch_expected && (policy->tier > prewarm_tier))
+    {
+        policy->tier = prewarm_tier;
+        policy->idle_scan_count = RESET_CAPSENSE_FAST_SCAN_COUNT;
+        transition = SCAN_POLICY_PRE_WARM;
+    }
+    else if (policy->is_touch_expected && (policy->tier == prewarm_tier))
+    {
+        /* Hold the pre-warm tier until the expected touch or the end of the
+         * prediction window.
+         */
+    }
+    else if ((policy->tier + 1U) < policy->num_tiers)
+    {
+        if (max_idle_scans > policy->idle_scan_count)
+        {
+            policy->idle_scan_count++;
+        }
+        else
+        {
+            policy->tier++;
+            policy->idle_scan_count = RESET_CAPSENSE_FAST_SCAN_COUNT;
+            transition = SCAN_POLICY_STEP_DOWN;
+        }
+    }
+    else
+    {
+        /* Already in the slowest tier. */
+    }
+
+    return transition;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_policy_set_hint
+********************************************************************************
+* Summary: Sets the touch predictor hints used by the next scan_policy_update.
+*
+* Parameters:
+* scan_policy_t *policy: Pointer to the scan policy state.
+* bool is_touch_expected: A touch is expected soon.
+* bool is_quiet_period: The current time falls into a usually quiet period.
+*
+*******************************************************************************/
+void scan_policy_set_hint(scan_policy_t *policy, bool is_touch_expected,
+                          bool is_quiet_period)
+{
+    policy->is_touch_expected = is_touch_expected;
+    policy->is_quiet_period = is_quiet_period;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_policy_get_tier
+********************************************************************************
+* Summary: Returns the index of the current tier in the tier table.
+*
+*******************************************************************************/
+uint32_t scan_policy_get_tier(const scan_policy_t *policy)
+{
+    return policy->tier;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_policy_get_widget_id
+********************************************************************************
+* Summary: Returns the widget to be scanned in the current tier.
+*
+*******************************************************************************/
+uint32_t scan_policy_get_widget_id(const scan_policy_t *policy)
+{
+    return policy->tiers[policy->tier].widget_id;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_policy_get_interval_ms
+********************************************************************************
+* Summary: Returns the scan timer period of the current tier.
+*
+*******************************************************************************/
+uint32_t scan_policy_get_interval_ms(const scan_policy_t *policy)
+{
+    return policy->tiers[policy->tier].interval_ms;
+}
+
+
+/* [] END OF FILE */
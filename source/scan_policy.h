@@ -0,0 +1,163 @@
+/******************************************************************************
+* File Name:   scan_policy.h
+*
+* Description: This file contains the data types and function prototypes of the
+*              CapSense scan-rate policy used by capsense.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SCAN_POLICY_H
+#define SOURCE_SCAN_POLICY_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+/* The scan policy does not depend on the PDL, HAL, CapSense middleware or
+ * FreeRTOS so that it can be compiled and driven by scripted touch traces
+ * outside of the target.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* In this example, the CapSense scans are performed at different rates
+ * depending on touch detection. The scan rate is organized in tiers: the
+ * example starts in the fastest tier, steps down to the next slower tier
+ * after a number of consecutive scans without touch, and jumps straight back
+ * to the fastest tier when a touch is detected in any tier.
+ *
+ * The scans performed every CAPSENSE_FAST_SCAN_INTERVAL_MS are fast scans and
+ * the scans performed at CAPSENSE_SLOW_SCAN_INTERVAL_MS are slow scans.
+ * CAPSENSE_MEDIUM_SCAN_INTERVAL_MS is an intermediate slider tier and
+ * CAPSENSE_DEEP_IDLE_SCAN_INTERVAL_MS is used when the device has been idle
+ * for a long time.
+ */
+#define CAPSENSE_FAST_SCAN_INTERVAL_MS       (20U)
+#define CAPSENSE_MEDIUM_SCAN_INTERVAL_MS     (50U)
+#define CAPSENSE_SLOW_SCAN_INTERVAL_MS       (200U)
+#define CAPSENSE_DEEP_IDLE_SCAN_INTERVAL_MS  (1000U)
+
+/* Maximum number of fast scans after which the scan policy steps down to the
+ * next tier.
+ */
+#define MAX_CAPSENSE_FAST_SCAN_COUNT         (100U)
+
+/* Maximum number of scans without touch in the medium and slow tiers after
+ * which the scan policy steps down to the next tier.
+ */
+#define MAX_CAPSENSE_MEDIUM_SCAN_COUNT       (40U)
+#define MAX_CAPSENSE_SLOW_SCAN_COUNT         (150U)
+
+/* This is the value of the idle scan counter at the beginning of every tier. */
+#define RESET_CAPSENSE_FAST_SCAN_COUNT       (1U)
+
+/* Tier the scan policy moves to, and does not step down from, while the touch
+ * predictor expects a touch.
+ */
+#define SCAN_POLICY_PREWARM_TIER             (1U)
+
+/* During usually quiet periods, max_idle_scans of every tier is divided by
+ * 2^SCAN_POLICY_QUIET_IDLE_SHIFT.
+ */
+#define SCAN_POLICY_QUIET_IDLE_SHIFT         (2U)
+
+/* Maximum number of tiers supported by the scan policy. */
+#define SCAN_POLICY_MAX_TIERS                (8U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Result of a scan policy update. */
+typedef enum
+{
+    SCAN_POLICY_NO_CHANGE,
+    SCAN_POLICY_STEP_DOWN,
+    SCAN_POLICY_WAKE_UP,
+    SCAN_POLICY_PRE_WARM
+} scan_policy_transition_t;
+
+/* Scan-rate tier. The last tier of a table never steps down, and its
+ * max_idle_scans is ignored.
+ */
+typedef struct
+{
+    uint32_t interval_ms;
+    uint32_t widget_id;
+    uint32_t max_idle_scans;
+} scan_policy_tier_t;
+
+/* Scan policy state. The statistics are accumulated in modeled time, i.e. each
+ * scan accounts for one timer period of the tier it was performed in.
+ */
+typedef struct
+{
+    const scan_policy_tier_t *tiers;
+    uint32_t num_tiers;
+    uint32_t tier;
+    uint32_t idle_scan_count;
+
+    /* Hints from the touch predictor */
+    bool is_touch_expected;
+    bool is_quiet_period;
+
+    /* Statistics */
+    uint32_t scan_total[SCAN_POLICY_MAX_TIERS];
+    uint32_t scan_time_ms[SCAN_POLICY_MAX_TIERS];
+} scan_policy_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void scan_policy_init(scan_policy_t *policy, const scan_policy_tier_t *tiers,
+                      uint32_t num_tiers);
+scan_policy_transition_t scan_policy_update(scan_policy_t *policy,
+                                            bool is_touch_detected);
+void scan_policy_set_hint(scan_policy_t *policy, bool is_touch_expected,
+                          bool is_quiet_period);
+uint32_t scan_policy_get_tier(const scan_policy_t *policy);
+uint32_t scan_policy_get_widget_id(const scan_policy_t *policy);
+uint32_t scan_policy_get_interval_ms(const scan_policy_t *policy);
+
+
+#endif /* SOURCE_SCAN_POLICY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,354 @@
+/******************************************************************************
+* File Name:   scan_stats.c
+*
+* Description: This file contains function definitions of the scan latency and
+*              jitter instrumentation. The scan path is timestamped with the DWT
+*              cycle counter and per-widget statistics are accumulated when the
+*              scan has been processed.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+#include "scan_stats.h"
+
+#include <stdio.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SCAN_STATS_TOTAL                (SCAN_STATS_NUM_POINTS - 1U)
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+/* Timestamps of the ongoing scan. */
+static volatile uint32_t scan_stats_timestamp[SCAN_STATS_NUM_POINTS];
+
+static scan_stats_widget_t scan_stats_widget[CY_CAPSENSE_WIDGET_COUNT];
+
+/* Ring buffer of the most recent trigger-to-report latencies in cycles, and
+ * the widget each of them belongs to.
+ */
+static uint32_t scan_stats_ring[SCAN_STATS_RING_SIZE];
+static uint8_t scan_stats_ring_widget[SCAN_STATS_RING_SIZE];
+static uint32_t scan_stats_ring_index;
+static uint32_t scan_stats_ring_count;
+
+static const char *const scan_stats_interval_name[SCAN_STATS_NUM_POINTS] =
+{
+    "trigger -> scan start",
+    "scan start -> scan end",
+    "scan end -> processed",
+    "trigger -> processed"
+};
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void update_interval(scan_stats_interval_t *interval, uint32_t cycles);
+static uint32_t cycles_to_us(uint32_t cycles);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: scan_stats_init
+********************************************************************************
+* Summary: Enables the DWT cycle counter and clears the statistics.
+*
+*******************************************************************************/
+void scan_stats_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (uint32_t wd = 0; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        for (uint32_t i = 0; i < SCAN_STATS_NUM_POINTS; i++)
+        {
+            scan_stats_widget[wd].interval[i].min = UINT32_MAX;
+            scan_stats_widget[wd].interval[i].max = 0;
+            scan_stats_widget[wd].interval[i].sum = 0;
+            scan_stats_widget[wd].interval[i].count = 0;
+        }
+
+        scan_stats_widget[wd].processing.min = UINT32_MAX;
+        scan_stats_widget[wd].processing.max = 0;
+        scan_stats_widget[wd].processing.sum = 0;
+        scan_stats_widget[wd].processing.count = 0;
+
+        for (uint32_t i = 0; i < SCAN_STATS_HIST_BUCKETS; i++)
+        {
+            scan_stats_widget[wd].histogram[i] = 0;
+        }
+    }
+
+    scan_stats_ring_index = 0;
+    scan_stats_ring_count = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_stats_mark
+********************************************************************************
+* Summary: Timestamps an instrumentation point of the ongoing scan. Can be
+* called from interrupt context.
+*
+*******************************************************************************/
+void scan_stats_mark(scan_stats_point_t point)
+{
+    scan_stats_timestamp[point] = SCAN_STATS_GET_CYCLES();
+}
+
+
+/*******************************************************************************
+* Function Name: scan_stats_complete
+********************************************************************************
+* Summary: Timestamps SCAN_STATS_PROCESS_END and accumulates the intervals of
+* the scan into the statistics of widget_id.
+*
+* Parameters:
+* uint32_t widget_id: The widget that was scanned and processed.
+*
+*******************************************************************************/
+void scan_stats_complete(uint32_t widget_id)
+{
+    scan_stats_widget_t *stats;
+    uint32_t total;
+    uint32_t bucket;
+
+    scan_stats_mark(SCAN_STATS_PROCESS_END);
+
+    if (CY_CAPSENSE_WIDGET_COUNT <= widget_id)
+    {
+        return;
+    }
+
+    stats = &scan_stats_widget[widget_id];
+
+    for (uint32_t i = 0; i < SCAN_STATS_TOTAL; i++)
+    {
+        update_interval(&stats->interval[i],
+                        scan_stats_timestamp[i + 1U] - scan_stats_timestamp[i]);
+    }
+
+    total = scan_stats_timestamp[SCAN_STATS_PROCESS_END] - scan_stats_timestamp[SCAN_STATS_TRIGGER];
+    update_interval(&stats->interval[SCAN_STATS_TOTAL], total);
+
+    bucket = cycles_to_us(total) / SCAN_STATS_HIST_BUCKET_US;
+    if (SCAN_STATS_HIST_BUCKETS <= bucket)
+    {
+        bucket = SCAN_STATS_HIST_BUCKETS - 1U;
+    }
+    stats->histogram[bucket]++;
+
+    scan_stats_ring[scan_stats_ring_index] = total;
+    scan_stats_ring_widget[scan_stats_ring_index] = (uint8_t)widget_id;
+    scan_stats_ring_index = (scan_stats_ring_index + 1U) % SCAN_STATS_RING_SIZE;
+    if (SCAN_STATS_RING_SIZE > scan_stats_ring_count)
+    {
+        scan_stats_ring_count++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: scan_stats_record_processing
+********************************************************************************
+* Summary: Accumulates the time spent processing widget_id after a scan.
+*
+* Parameters:
+* uint32_t widget_id: The widget that was processed.
+* uint32_t cycles: The processing time in CPU cycles.
+*
+*******************************************************************************/
+void scan_stats_record_processing(uint32_t widget_id, uint32_t cycles)
+{
+    if (CY_CAPSENSE_WIDGET_COUNT > widget_id)
+    {
+        update_interval(&scan_stats_widget[widget_id].processing, cycles);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: scan_stats_get
+********************************************************************************
+* Summary: Returns the statistics of widget_id, or NULL for an invalid widget.
+*
+*******************************************************************************/
+const scan_stats_widget_t *scan_stats_get(uint32_t widget_id)
+{
+    return (CY_CAPSENSE_WIDGET_COUNT > widget_id) ? &scan_stats_widget[widget_id] : NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_stats_get_recent
+********************************************************************************
+* Summary: Copies the most recent trigger-to-report latencies, oldest first.
+*
+* Parameters:
+* uint32_t *latencies: Output of SCAN_STATS_RING_SIZE latencies in CPU cycles.
+* uint8_t *widget_ids: Output of the SCAN_STATS_RING_SIZE widgets of the
+* latencies.
+*
+* Return:
+* uint32_t: Number of latencies copied.
+*
+*******************************************************************************/
+uint32_t scan_stats_get_recent(uint32_t *latencies, uint8_t *widget_ids)
+{
+    uint32_t index = (scan_stats_ring_index + SCAN_STATS_RING_SIZE - scan_stats_ring_count) %
+                     SCAN_STATS_RING_SIZE;
+
+    for (uint32_t i = 0; i < scan_stats_ring_count; i++)
+    {
+        latencies[i] = scan_stats_ring[index];
+        widget_ids[i] = scan_stats_ring_widget[index];
+        index = (index + 1U) % SCAN_STATS_RING_SIZE;
+    }
+
+    return scan_stats_ring_count;
+}
+
+
+/*******************************************************************************
+* Function Name: scan_stats_print
+********************************************************************************
+* Summary: Prints the statistics of all widgets and the ring buffer of the most
+* recent latencies on the serial terminal. All values are in microseconds,
+* except for the processing time, which is also printed in CPU cycles.
+*
+*******************************************************************************/
+void scan_stats_print(void)
+{
+    const scan_stats_interval_t *interval;
+    uint32_t latencies[SCAN_STATS_RING_SIZE];
+    uint8_t widget_ids[SCAN_STATS_RING_SIZE];
+    uint32_t num_latencies;
+
+    for (uint32_t wd = 0; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        printf("Widget %lu latency (us):\r\n", (unsigned long)wd);
+
+        for (uint32_t i = 0; i < SCAN_STATS_NUM_POINTS; i++)
+        {
+            interval = &scan_stats_widget[wd].interval[i];
+            if (0U == interval->count)
+            {
+                continue;
+            }
+
+            printf("  %-24s min %lu max %lu mean %lu\r\n", scan_stats_interval_name[i],
+                   (unsigned long)cycles_to_us(interval->min),
+                   (unsigned long)cycles_to_us(interval->max),
+                   (unsigned long)cycles_to_us((uint32_t)(interval->sum / interval->count)));
+        }
+
+        interval = &scan_stats_widget[wd].processing;
+        if (0U != interval->count)
+        {
+            printf("  %-24s min %lu max %lu mean %lu cycles, mean %lu us\r\n", "processing",
+                   (unsigned long)interval->min, (unsigned long)interval->max,
+                   (unsigned long)(interval->sum / interval->count),
+                   (unsigned long)cycles_to_us((uint32_t)(interval->sum / interval->count)));
+        }
+
+        printf("  histogram (%u us buckets):", SCAN_STATS_HIST_BUCKET_US);
+        for (uint32_t i = 0; i < SCAN_STATS_HIST_BUCKETS; i++)
+        {
+            printf(" %lu", (unsigned long)scan_stats_widget[wd].histogram[i]);
+        }
+        printf("\r\n");
+    }
+
+    num_latencies = scan_stats_get_recent(latencies, widget_ids);
+    printf("Recent latencies (widget:us):");
+    for (uint32_t i = 0; i < num_latencies; i++)
+    {
+        printf(" %u:%lu", widget_ids[i], (unsigned long)cycles_to_us(latencies[i]));
+    }
+    printf("\r\n");
+}
+
+
+/*******************************************************************************
+* Function Name: update_interval
+********************************************************************************
+* Summary: Accumulates one sample into the interval statistics.
+*
+*******************************************************************************/
+static void update_interval(scan_stats_interval_t *interval, uint32_t cycles)
+{
+    if (cycles < interval->min)
+    {
+        interval->min = cycles;
+    }
+    if (cycles > interval->max)
+    {
+        interval->max = cycles;
+    }
+    interval->sum += cycles;
+    interval->count++;
+}
+
+
+/*******************************************************************************
+* Function Name: cycles_to_us
+********************************************************************************
+* Summary: Converts CPU cycles to microseconds.
+*
+*******************************************************************************/
+static uint32_t cycles_to_us(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000U) / SystemCoreClock);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,132 @@
+/******************************************************************************
+* File Name:   scan_stats.h
+*
+* Description: This file contains macros and function prototypes of the scan
+*              latency and jitter instrumentation.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SCAN_STATS_H
+#define SOURCE_SCAN_STATS_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of latency histogram buckets and the width of each bucket. The last
+ * bucket also counts all larger values.
+ */
+#define SCAN_STATS_HIST_BUCKETS         (16U)
+#define SCAN_STATS_HIST_BUCKET_US       (250U)
+
+/* Number of most recent trigger-to-report latencies kept in the ring buffer. */
+#define SCAN_STATS_RING_SIZE            (32U)
+
+/* Cycle counter used for the timestamps. Defaults to the DWT cycle counter of
+ * the CM4; a host build can provide its own definition, e.g. host_sim derives
+ * it from the simulated time.
+ */
+#ifndef SCAN_STATS_GET_CYCLES
+#define SCAN_STATS_GET_CYCLES()         (DWT->CYCCNT)
+#endif
+
+/* The instrumentation points compile to nothing unless
+ * SCAN_LATENCY_STATS_ENABLE is defined.
+ */
+#if (defined(SCAN_LATENCY_STATS_ENABLE))
+#define SCAN_STATS_MARK(point)          scan_stats_mark(point)
+#else
+#define SCAN_STATS_MARK(point)
+#endif /* SCAN_LATENCY_STATS_ENABLE */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Instrumentation points of a scan, in the order they occur. */
+typedef enum
+{
+    SCAN_STATS_TRIGGER,         /* Scan timer expired */
+    SCAN_STATS_SCAN_START,      /* Cy_CapSense_Scan called */
+    SCAN_STATS_SCAN_END,        /* End-of-scan callback */
+    SCAN_STATS_PROCESS_END,     /* process_touch returned */
+    SCAN_STATS_NUM_POINTS
+} scan_stats_point_t;
+
+/* Statistics of the time between two consecutive instrumentation points, and
+ * of the total time from SCAN_STATS_TRIGGER to SCAN_STATS_PROCESS_END (the
+ * last entry), in CPU cycles.
+ */
+typedef struct
+{
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t count;
+} scan_stats_interval_t;
+
+/* The processing time of the widget alone is kept separately, in CPU cycles,
+ * so that the processing paths of a widget can be compared between builds.
+ */
+typedef struct
+{
+    scan_stats_interval_t interval[SCAN_STATS_NUM_POINTS];
+    scan_stats_interval_t processing;
+    uint32_t histogram[SCAN_STATS_HIST_BUCKETS];
+} scan_stats_widget_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void scan_stats_init(void);
+void scan_stats_mark(scan_stats_point_t point);
+void scan_stats_complete(uint32_t widget_id);
+void scan_stats_record_processing(uint32_t widget_id, uint32_t cycles);
+const scan_stats_widget_t *scan_stats_get(uint32_t widget_id);
+uint32_t scan_stats_get_recent(uint32_t *latencies, uint8_t *widget_ids);
+void scan_stats_print(void);
+
+
+#endif /* SOURCE_SCAN_STATS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name:   sram_retention.c
+*
+* Description: This file contains the functions that power down the unused
+*              SRAM0 macros in deep sleep. The macros that hold the CM4
+*              vectors, data, bss, heap or stack are derived from the linker
+*              symbols and are never powered down.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+
+#include "sram_retention.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Writing this value with the SRAM power macro key powers the macro off in
+ * deep sleep.
+ */
+#define SRAM_RETENTION_POWER_OFF             (0x05FA0000UL)
+
+/* Only the GCC linker scripts export the RAM boundary symbols. With the other
+ * toolchains the mask is applied as configured and tools/sram_retention.py
+ * cannot check it.
+ */
+#if (defined(__GNUC__) && !defined(__ARMCC_VERSION))
+#define SRAM_RETENTION_USE_LINKER_SYMBOLS
+#endif
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+#if (defined(SRAM_RETENTION_USE_LINKER_SYMBOLS))
+/* CM4 RAM boundaries defined in the linker script. The vector table is the
+ * first section and the stack is the last section of the ram region.
+ */
+extern uint32_t __ram_vectors_start__[];
+extern uint32_t __StackTop[];
+#endif
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: sram_retention_get_live_mask
+********************************************************************************
+* Summary: Returns the mask of the SRAM0 macros that hold the CM4 RAM of this
+* image.
+*
+* Return:
+*  uint32_t: bit n is set if macro n must be retained in deep sleep.
+*
+*******************************************************************************/
+uint32_t sram_retention_get_live_mask(void)
+{
+    uint32_t live_mask = 0U;
+
+#if (defined(SRAM_RETENTION_USE_LINKER_SYMBOLS))
+    uint32_t start = (uint32_t)__ram_vectors_start__;
+    uint32_t end = (uint32_t)__StackTop;
+    uint32_t sram0_end = CY_SRAM_BASE +
+                         (CPUSS_RAMC0_MACRO_NR * SRAM_RETENTION_MACRO_SIZE);
+
+    /* The RAM may be placed outside SRAM0, e.g. in SRAM2 of CY8C6xxA. */
+    if ((start < sram0_end) && (end > CY_SRAM_BASE))
+    {
+        uint32_t first = (CY_MAX(start, CY_SRAM_BASE) - CY_SRAM_BASE) /
+                         SRAM_RETENTION_MACRO_SIZE;
+        uint32_t last = (CY_MIN(end, sram0_end) - 1U - CY_SRAM_BASE) /
+                        SRAM_RETENTION_MACRO_SIZE;
+
+        for (uint32_t i = first; i <= last; i++)
+        {
+            live_mask |= (1UL << i);
+        }
+    }
+#endif /* SRAM_RETENTION_USE_LINKER_SYMBOLS */
+
+    return live_mask;
+}
+
+
+/*******************************************************************************
+* Function Name: sram_retention_power_down
+********************************************************************************
+* Summary: Configures the SRAM0 macros in the mask to power off in deep sleep.
+* The macros that hold the CM4 RAM are retained regardless of the mask, so that
+* a mask that is out of date with the linker script does not corrupt the
+* application state. The macros reserved for CM0+ and for the system calls are
+* not known to the CM4 image and must be excluded from the mask by the caller.
+*
+* Parameters:
+*  sram0_mask: bit n is set to power off macro n.
+*
+* Return:
+*  uint32_t: mask of the macros that are actually powered off.
+*
+*******************************************************************************/
+uint32_t sram_retention_power_down(uint32_t sram0_mask)
+{
+    uint32_t mask = sram0_mask & ~sram_retention_get_live_mask();
+
+    for (uint32_t i = 0U; i < CPUSS_RAMC0_MACRO_NR; i++)
+    {
+        if (0U != (mask & (1UL << i)))
+        {
+            CPUSS->RAM0_PWR_MACRO_CTL[i] = SRAM_RETENTION_POWER_OFF;
+        }
+    }
+
+    return mask & ((1UL << CPUSS_RAMC0_MACRO_NR) - 1UL);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,71 @@
+/******************************************************************************
+* File Name:   sram_retention.h
+*
+* Description: This file contains macros and function prototypes used by
+*              sram_retention.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SRAM_RETENTION_H
+#define SOURCE_SRAM_RETENTION_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of one SRAM0 power macro. The retention mask passed to
+ * sram_retention_power_down has one bit per macro: bit n covers the addresses
+ * [CY_SRAM_BASE + n * SRAM_RETENTION_MACRO_SIZE, + SRAM_RETENTION_MACRO_SIZE).
+ */
+#define SRAM_RETENTION_MACRO_SIZE            (0x8000UL)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t sram_retention_power_down(uint32_t sram0_mask);
+uint32_t sram_retention_get_live_mask(void);
+
+
+#endif /* SOURCE_SRAM_RETENTION_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,210 @@
+/******************************************************************************
+* File Name:   telemetry.c
+*
+* Description: This file contains function definitions of the binary telemetry
+*              encoder. It converts touch events into compact frames for field
+*              logging.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "telemetry.h"
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static uint32_t put_frame(uint8_t *frame, uint8_t type, const uint32_t *fields,
+                          uint32_t num_fields);
+static uint32_t put_varint(uint8_t *buffer, uint32_t value);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: telemetry_init
+********************************************************************************
+* Summary: Resets the encoder. The first frame is preceded by a sync frame.
+*
+*******************************************************************************/
+void telemetry_init(telemetry_encoder_t *encoder)
+{
+    encoder->last_timestamp_ms = 0U;
+    encoder->last_sync_ms = 0U;
+    encoder->is_sync_due = true;
+}
+
+
+/*******************************************************************************
+* Function Name: telemetry_request_sync
+********************************************************************************
+* Summary: Makes the next frame be preceded by a sync frame, so that the decoder
+* can re-anchor its time after frames have been lost.
+*
+*******************************************************************************/
+void telemetry_request_sync(telemetry_encoder_t *encoder)
+{
+    encoder->is_sync_due = true;
+}
+
+
+/*******************************************************************************
+* Function Name: telemetry_encode
+********************************************************************************
+* Summary: Encodes an event into a frame, preceded by a sync frame if one is
+* due.
+*
+* Parameters:
+* telemetry_encoder_t *encoder: Encoder state.
+* const touch_event_t *event: Event to be encoded.
+* uint8_t *frame: Output buffer of at least TELEMETRY_MAX_OUTPUT_SIZE bytes.
+*
+* Return:
+* uint32_t: Length of the output in bytes.
+*
+*******************************************************************************/
+uint32_t telemetry_encode(telemetry_encoder_t *encoder, const touch_event_t *event,
+                          uint8_t *frame)
+{
+    uint32_t fields[4];
+    uint32_t num_fields = 4U;
+    uint32_t length = 0U;
+
+    if (encoder->is_sync_due ||
+        ((event->timestamp_ms - encoder->last_sync_ms) >= TELEMETRY_SYNC_INTERVAL_MS))
+    {
+        length = put_frame(frame, TELEMETRY_SYNC_TYPE, &event->timestamp_ms, 1U);
+
+        encoder->last_timestamp_ms = event->timestamp_ms;
+        encoder->last_sync_ms = event->timestamp_ms;
+        encoder->is_sync_due = false;
+    }
+
+    fields[0] = event->timestamp_ms - encoder->last_timestamp_ms;
+    fields[1] = event->value;
+    fields[2] = event->arg;
+    fields[3] = ((uint32_t)event->data << 1) ^ (uint32_t)(event->data >> 31);
+
+    encoder->last_timestamp_ms = event->timestamp_ms;
+
+    while ((num_fields > 1U) && (0U == fields[num_fields - 1U]))
+    {
+        num_fields--;
+    }
+
+    return length + put_frame(&frame[length], event->type, fields, num_fields);
+}
+
+
+/*******************************************************************************
+* Function Name: telemetry_crc8
+********************************************************************************
+* Summary: Calculates the CRC-8 (polynomial 0x07, initial value 0) of data.
+*
+*******************************************************************************/
+uint8_t telemetry_crc8(const uint8_t *data, uint32_t length)
+{
+    uint8_t crc = 0U;
+
+    for (uint32_t i = 0U; i < length; i++)
+    {
+        crc ^= data[i];
+
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (0U != (crc & 0x80U)) ? (uint8_t)((crc << 1) ^ 0x07U) : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+
+/*******************************************************************************
+* Function Name: put_frame
+********************************************************************************
+* Summary: Writes a frame with the fields as varints and returns its length in
+* bytes.
+*
+*******************************************************************************/
+static uint32_t put_frame(uint8_t *frame, uint8_t type, const uint32_t *fields,
+                          uint32_t num_fields)
+{
+    uint8_t *payload = &frame[TELEMETRY_HEADER_SIZE];
+    uint32_t length = 0U;
+
+    for (uint32_t i = 0U; i < num_fields; i++)
+    {
+        length += put_varint(&payload[length], fields[i]);
+    }
+
+    frame[0] = TELEMETRY_SYNC_BYTE;
+    frame[1] = type;
+    frame[2] = (uint8_t)length;
+    frame[TELEMETRY_HEADER_SIZE + length] = telemetry_crc8(&frame[1], length + 2U);
+
+    return TELEMETRY_HEADER_SIZE + length + 1U;
+}
+
+
+/*******************************************************************************
+* Function Name: put_varint
+********************************************************************************
+* Summary: Writes value as an LEB128 varint and returns its length in bytes.
+*
+*******************************************************************************/
+static uint32_t put_varint(uint8_t *buffer, uint32_t value)
+{
+    uint32_t length = 0U;
+
+    while (value >= 0x80U)
+    {
+        buffer[length++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+
+    buffer[length++] = (uint8_t)value;
+
+    return length;
+}
+
+
+/* [] END OF FILE */
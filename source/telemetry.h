@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name:   telemetry.h
+*
+* Description: This file contains macros and function prototypes of the binary
+*              telemetry encoder.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TELEMETRY_H
+#define SOURCE_TELEMETRY_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "touch_event.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frame layout:
+ *
+ *   [TELEMETRY_SYNC_BYTE][type][len][payload: len bytes][crc8]
+ *
+ * type is a touch_event_type_t value. The CRC-8 (polynomial 0x07, initial
+ * value 0) covers type, len, and the payload. The payload is a sequence of
+ * LEB128 varints, in this order:
+ *
+ *   1. time since the previous frame, in ms
+ *   2. value
+ *   3. arg
+ *   4. data, zigzag-encoded
+ *
+ * Trailing fields that are zero are omitted, and the decoder substitutes zero
+ * for missing fields. tools/telemetry_decode.py decodes the stream.
+ *
+ * A frame of type TELEMETRY_SYNC_TYPE carries the absolute timestamp in ms
+ * as its only field, and the next frame is timed relative to it. A lost frame
+ * would otherwise shift the timestamps of all the frames after it, so a sync
+ * frame is sent before the first frame, before a frame that follows the last
+ * sync frame by TELEMETRY_SYNC_INTERVAL_MS or more, and after
+ * telemetry_request_sync, e.g. when events or bytes have been dropped. The
+ * decoder re-anchors its time on every sync frame.
+ */
+#define TELEMETRY_SYNC_BYTE                  (0xA5U)
+#define TELEMETRY_SYNC_TYPE                  (0x7FU)
+#define TELEMETRY_SYNC_INTERVAL_MS           (10000U)
+#define TELEMETRY_HEADER_SIZE                (3U)
+#define TELEMETRY_MAX_PAYLOAD_SIZE           (5U + 3U + 2U + 5U)
+#define TELEMETRY_MAX_FRAME_SIZE             (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD_SIZE + 1U)
+#define TELEMETRY_SYNC_FRAME_SIZE            (TELEMETRY_HEADER_SIZE + 5U + 1U)
+
+/* Output of telemetry_encode: a frame, preceded by a sync frame if it is due. */
+#define TELEMETRY_MAX_OUTPUT_SIZE            (TELEMETRY_SYNC_FRAME_SIZE + TELEMETRY_MAX_FRAME_SIZE)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t last_timestamp_ms;
+    uint32_t last_sync_ms;
+    bool is_sync_due;
+} telemetry_encoder_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void telemetry_init(telemetry_encoder_t *encoder);
+void telemetry_request_sync(telemetry_encoder_t *encoder);
+uint32_t telemetry_encode(telemetry_encoder_t *encoder, const touch_event_t *event,
+                          uint8_t *frame);
+uint8_t telemetry_crc8(const uint8_t *data, uint32_t length);
+
+
+#endif /* SOURCE_TELEMETRY_H */
+
+/* [] END OF FILE */
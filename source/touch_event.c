@@ -0,0 +1,495 @@
+/******************************************************************************
+* File Name:   touch_event.c
+*
+* Description: This file contains function definitions of the touch event queue
+*              and its consumer task. capsense_task posts compact binary events
+*              into a lock-free single-producer single-consumer queue and never
+*              waits for the UART; the low-priority consumer task formats and
+*              prints them.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+#include "touch_event.h"
+#include "scan_policy.h"
+#include "gesture.h"
+#if (defined(STACK_MONITOR_ENABLE))
+#include "capsense.h"
+#include "timers.h"
+#include "wake_coalesce.h"
+#endif /* STACK_MONITOR_ENABLE */
+#if (defined(UART_TX_DMA_ENABLE))
+#include "uart_tx.h"
+#endif /* UART_TX_DMA_ENABLE */
+#if (defined(TELEMETRY_ENABLE))
+#include "telemetry.h"
+#include "cy_retarget_io.h"
+#endif /* TELEMETRY_ENABLE */
+
+#include <stdio.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TOUCH_EVENT_QUEUE_MASK               (TOUCH_EVENT_QUEUE_SIZE - 1U)
+
+/* With UART_TX_DMA_ENABLE, the events are sent through the DMA-driven UART
+ * path so that the CPU does not wait for the bytes to be shifted out.
+ */
+#if (defined(UART_TX_DMA_ENABLE))
+#define TOUCH_EVENT_PRINTF                   uart_tx_printf
+#else
+#define TOUCH_EVENT_PRINTF                   printf
+#endif /* UART_TX_DMA_ENABLE */
+
+/* With TELEMETRY_ENABLE, the events are sent as binary frames instead of
+ * text.
+ */
+#if (defined(TELEMETRY_ENABLE))
+#define TOUCH_EVENT_OUTPUT                   send_frame
+#else
+#define TOUCH_EVENT_OUTPUT                   print_event
+#endif /* TELEMETRY_ENABLE */
+
+/* The periodic stack check may be delayed by up to the slowest scan period so
+ * that it always falls on a scan wake-up.
+ */
+#define TOUCH_EVENT_STACK_CHECK_SLACK_MS     (CAPSENSE_DEEP_IDLE_SCAN_INTERVAL_MS)
+
+#if ((TOUCH_EVENT_QUEUE_SIZE & TOUCH_EVENT_QUEUE_MASK) != 0U)
+#error "TOUCH_EVENT_QUEUE_SIZE must be a power of two."
+#endif
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+TaskHandle_t touch_event_task_handle;
+
+/* The head index is written only by the producer and the tail index only by
+ * the consumer. volatile orders the accesses to the indices only; the entries
+ * are plain memory, which the compiler may move across them. A data memory
+ * barrier (which is also a compiler barrier) therefore separates the entry
+ * accesses from the index accesses on both sides: the producer writes the
+ * entry before it publishes the head, and the consumer reads the entry after
+ * it has loaded the head and before it releases the entry through the tail.
+ */
+static touch_event_t touch_event_queue[TOUCH_EVENT_QUEUE_SIZE];
+static volatile uint32_t touch_event_head;
+static volatile uint32_t touch_event_tail;
+static volatile uint32_t touch_event_dropped_count;
+
+#if (defined(STACK_MONITOR_ENABLE))
+/* Free stack of every task at its last report, in bytes. */
+static uint32_t reported_free_stack[TOUCH_EVENT_STACK_NUM_TASKS];
+static TickType_t last_stack_check_ticks;
+#endif /* STACK_MONITOR_ENABLE */
+
+#if (defined(TELEMETRY_ENABLE))
+static telemetry_encoder_t telemetry_encoder;
+static uint8_t telemetry_frame[TELEMETRY_MAX_OUTPUT_SIZE];
+#if (defined(UART_TX_DMA_ENABLE))
+static uint32_t telemetry_uart_dropped_count;
+#endif /* UART_TX_DMA_ENABLE */
+#else
+/* Indexed by touch_event_stack_task_t and runtime_stats_task_t. */
+static const char *const task_names[] =
+{
+    "CapSense Task",
+    "Touch Event Task",
+    "Timer Task",
+    "Idle Task"
+};
+#endif /* TELEMETRY_ENABLE */
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#if (defined(STACK_MONITOR_ENABLE))
+static void check_stack_high_water(void);
+static TickType_t get_stack_check_delay(void);
+#endif /* STACK_MONITOR_ENABLE */
+#if (defined(TELEMETRY_ENABLE))
+static void send_frame(const touch_event_t *event);
+#else
+static void print_event(const touch_event_t *event);
+#endif /* TELEMETRY_ENABLE */
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: touch_event_post
+********************************************************************************
+* Summary: Adds an event to the queue and notifies the consumer task. Never
+* blocks. If the queue is full, the event is dropped and counted.
+*
+* Parameters:
+* touch_event_type_t type: Event type.
+* uint8_t arg, uint16_t value, int32_t data: Event payload, see
+* touch_event_type_t.
+*
+* Return:
+* bool: Whether the event has been queued.
+*
+*******************************************************************************/
+bool touch_event_post(touch_event_type_t type, uint8_t arg, uint16_t value, int32_t data)
+{
+    uint32_t head = touch_event_head;
+    touch_event_t *event;
+
+    if ((head - touch_event_tail) >= TOUCH_EVENT_QUEUE_SIZE)
+    {
+        touch_event_dropped_count++;
+        return false;
+    }
+
+    /* Do not overwrite the entry before the consumer has released it. */
+    __DMB();
+
+    event = &touch_event_queue[head & TOUCH_EVENT_QUEUE_MASK];
+    event->type = (uint8_t)type;
+    event->arg = arg;
+    event->value = value;
+    event->data = data;
+    event->timestamp_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+    /* Publish the entry only after it has been written. */
+    __DMB();
+    touch_event_head = head + 1U;
+
+    if (NULL != touch_event_task_handle)
+    {
+        xTaskNotifyGive(touch_event_task_handle);
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: touch_event_get
+********************************************************************************
+* Summary: Removes the oldest event from the queue.
+*
+* Return:
+* bool: Whether an event has been returned.
+*
+*******************************************************************************/
+bool touch_event_get(touch_event_t *event)
+{
+    uint32_t tail = touch_event_tail;
+
+    if (tail == touch_event_head)
+    {
+        return false;
+    }
+
+    /* Read the entry only after the head that published it. */
+    __DMB();
+
+    *event = touch_event_queue[tail & TOUCH_EVENT_QUEUE_MASK];
+
+    /* Release the entry only after it has been read. */
+    __DMB();
+    touch_event_tail = tail + 1U;
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: touch_event_get_dropped_count
+********************************************************************************
+* Summary: Returns the number of events dropped because the queue was full.
+*
+*******************************************************************************/
+uint32_t touch_event_get_dropped_count(void)
+{
+    return touch_event_dropped_count;
+}
+
+
+/*******************************************************************************
+* Function Name: touch_event_task
+********************************************************************************
+* Summary: Consumer task. Waits for events and prints them on the serial
+* terminal.
+*
+* Parameters:
+* void *arg: unused parameter.
+*
+*******************************************************************************/
+void touch_event_task(void *arg)
+{
+    touch_event_t event;
+    uint32_t reported_dropped_count = 0;
+
+    (void)arg;
+
+#if (defined(TELEMETRY_ENABLE))
+    telemetry_init(&telemetry_encoder);
+#endif /* TELEMETRY_ENABLE */
+
+    for (;;)
+    {
+    #if (defined(STACK_MONITOR_ENABLE))
+        /* Also wake up for the periodic stack check, together with a scan. */
+        ulTaskNotifyTake(pdTRUE, get_stack_check_delay());
+    #else
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    #endif /* STACK_MONITOR_ENABLE */
+
+        while (touch_event_get(&event))
+        {
+            TOUCH_EVENT_OUTPUT(&event);
+        }
+
+        if (reported_dropped_count != touch_event_dropped_count)
+        {
+            reported_dropped_count = touch_event_dropped_count;
+
+        #if (defined(TELEMETRY_ENABLE))
+            /* Re-anchor the time of the decoder after the gap. */
+            telemetry_request_sync(&telemetry_encoder);
+        #endif /* TELEMETRY_ENABLE */
+
+            event.type = (uint8_t)TOUCH_EVENT_DROPPED;
+            event.arg = 0U;
+            event.value = 0U;
+            event.data = (int32_t)reported_dropped_count;
+            event.timestamp_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+            TOUCH_EVENT_OUTPUT(&event);
+        }
+
+    #if (defined(STACK_MONITOR_ENABLE))
+        check_stack_high_water();
+    #endif /* STACK_MONITOR_ENABLE */
+    }
+}
+
+
+#if (defined(STACK_MONITOR_ENABLE))
+/*******************************************************************************
+* Function Name: check_stack_high_water
+********************************************************************************
+* Summary: Reports the minimum free stack of the CapSense task, this task, and
+* the timer daemon task whenever it has decreased. The check scans the stack
+* fill pattern, so it runs at most once per TOUCH_EVENT_STACK_CHECK_INTERVAL_MS.
+*
+*******************************************************************************/
+static void check_stack_high_water(void)
+{
+    TickType_t now = xTaskGetTickCount();
+    TaskHandle_t tasks[TOUCH_EVENT_STACK_NUM_TASKS];
+    touch_event_t event;
+    uint32_t free_stack;
+
+    if ((0U != last_stack_check_ticks) &&
+        ((now - last_stack_check_ticks) < pdMS_TO_TICKS(TOUCH_EVENT_STACK_CHECK_INTERVAL_MS)))
+    {
+        return;
+    }
+    last_stack_check_ticks = (0U != now) ? now : 1U;
+
+    tasks[TOUCH_EVENT_STACK_CAPSENSE_TASK] = capsense_task_handle;
+    tasks[TOUCH_EVENT_STACK_TOUCH_EVENT_TASK] = touch_event_task_handle;
+    tasks[TOUCH_EVENT_STACK_TIMER_TASK] = xTimerGetTimerDaemonTaskHandle();
+
+    for (uint32_t i = 0U; i < (uint32_t)TOUCH_EVENT_STACK_NUM_TASKS; i++)
+    {
+        if (NULL == tasks[i])
+        {
+            continue;
+        }
+
+        free_stack = (uint32_t)uxTaskGetStackHighWaterMark(tasks[i]) * sizeof(StackType_t);
+
+        /* reported_free_stack is 0 until the first report. */
+        if ((0U == reported_free_stack[i]) || (free_stack < reported_free_stack[i]))
+        {
+            reported_free_stack[i] = free_stack;
+
+            event.type = (uint8_t)TOUCH_EVENT_STACK_HIGH_WATER;
+            event.arg = (uint8_t)i;
+            event.value = 0U;
+            event.data = (int32_t)free_stack;
+            event.timestamp_ms = (uint32_t)(now * portTICK_PERIOD_MS);
+            TOUCH_EVENT_OUTPUT(&event);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: get_stack_check_delay
+********************************************************************************
+* Summary: Returns the ticks until the next stack check, moved to the first
+* scan wake-up within TOUCH_EVENT_STACK_CHECK_SLACK_MS by wake_coalesce, so
+* that the check does not add an exit from deep sleep.
+*
+*******************************************************************************/
+static TickType_t get_stack_check_delay(void)
+{
+    TickType_t elapsed = xTaskGetTickCount() - last_stack_check_ticks;
+    TickType_t delay = 0U;
+
+    if ((0U != last_stack_check_ticks) &&
+        (elapsed < pdMS_TO_TICKS(TOUCH_EVENT_STACK_CHECK_INTERVAL_MS)))
+    {
+        delay = pdMS_TO_TICKS(TOUCH_EVENT_STACK_CHECK_INTERVAL_MS) - elapsed;
+    }
+
+    return wake_coalesce_get_delay(delay, pdMS_TO_TICKS(TOUCH_EVENT_STACK_CHECK_SLACK_MS));
+}
+#endif /* STACK_MONITOR_ENABLE */
+
+
+#if (defined(TELEMETRY_ENABLE))
+/*******************************************************************************
+* Function Name: send_frame
+********************************************************************************
+* Summary: Encodes an event into a binary telemetry frame and sends it. If
+* bytes have been dropped by the UART, the next frame is preceded by a sync
+* frame.
+*
+*******************************************************************************/
+static void send_frame(const touch_event_t *event)
+{
+    uint32_t length = telemetry_encode(&telemetry_encoder, event, telemetry_frame);
+
+#if (defined(UART_TX_DMA_ENABLE))
+    uart_tx_write((const char *)telemetry_frame, length);
+
+    if (telemetry_uart_dropped_count != uart_tx_get_dropped_count())
+    {
+        telemetry_uart_dropped_count = uart_tx_get_dropped_count();
+        telemetry_request_sync(&telemetry_encoder);
+    }
+#else
+    size_t tx_length = length;
+
+    if ((CY_RSLT_SUCCESS != cyhal_uart_write(&cy_retarget_io_uart_obj, telemetry_frame, &tx_length)) ||
+        (tx_length != length))
+    {
+        telemetry_request_sync(&telemetry_encoder);
+    }
+#endif /* UART_TX_DMA_ENABLE */
+}
+#else
+/*******************************************************************************
+* Function Name: print_event
+********************************************************************************
+* Summary: Prints an event in the same format as the example prints it without
+* the event queue.
+*
+*******************************************************************************/
+static void print_event(const touch_event_t *event)
+{
+    switch (event->type)
+    {
+        case TOUCH_EVENT_SLIDER_POSITION:
+            TOUCH_EVENT_PRINTF("Slider position = %u\r\n", event->value);
+            break;
+
+        case TOUCH_EVENT_SCAN_RATE:
+            if (SCAN_POLICY_WAKE_UP == event->arg)
+            {
+                TOUCH_EVENT_PRINTF("Touch detected, switching to fast scan.\r\n");
+            }
+            else if (SCAN_POLICY_PRE_WARM == event->arg)
+            {
+                TOUCH_EVENT_PRINTF("Touch expected, switching to %u ms scan.\r\n", event->value);
+            }
+            else if (CY_CAPSENSE_LINEARSLIDER0_WDGT_ID == (uint32_t)event->data)
+            {
+                TOUCH_EVENT_PRINTF("Fast scan time-out, switching to %u ms scan.\r\n", event->value);
+            }
+            else
+            {
+                TOUCH_EVENT_PRINTF("Slow scan time-out, switching to %u ms scan.\r\n", event->value);
+            }
+            break;
+
+        case TOUCH_EVENT_GESTURE:
+            TOUCH_EVENT_PRINTF("Gesture: %s at %u, velocity = %ld\r\n",
+                               gesture_get_name((gesture_type_t)event->arg), event->value,
+                               (long)event->data);
+            break;
+
+        case TOUCH_EVENT_AVERAGE_CURRENT:
+            TOUCH_EVENT_PRINTF("Modeled average current = %lu.%03lu uA\r\n",
+                               (unsigned long)((uint32_t)event->data / 1000U),
+                               (unsigned long)((uint32_t)event->data % 1000U));
+            break;
+
+        case TOUCH_EVENT_TRIGGER_LATENCY:
+            TOUCH_EVENT_PRINTF("Max scan trigger latency = %lu us\r\n", (unsigned long)event->data);
+            break;
+
+        case TOUCH_EVENT_DROPPED:
+            TOUCH_EVENT_PRINTF("Touch events dropped = %lu\r\n", (unsigned long)event->data);
+            break;
+
+        case TOUCH_EVENT_STACK_HIGH_WATER:
+            TOUCH_EVENT_PRINTF("%s stack high water mark: %lu bytes free\r\n",
+                               task_names[event->arg], (unsigned long)event->data);
+            break;
+
+        case TOUCH_EVENT_RUN_TIME:
+            TOUCH_EVENT_PRINTF("%s run time = %lu us (%u.%u %%)\r\n",
+                               task_names[event->arg], (unsigned long)event->data,
+                               event->value / 10U, event->value % 10U);
+            break;
+
+        default:
+            break;
+    }
+}
+#endif /* TELEMETRY_ENABLE */
+
+
+/* [] END OF FILE */
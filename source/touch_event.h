@@ -0,0 +1,138 @@
+/******************************************************************************
+* File Name:   touch_event.h
+*
+* Description: This file contains macros, data types and function prototypes of
+*              the touch event queue and its consumer task.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TOUCH_EVENT_H
+#define SOURCE_TOUCH_EVENT_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of entries in the event queue. Must be a power of two. */
+#define TOUCH_EVENT_QUEUE_SIZE               (32U)
+
+/* The consumer task runs below the CapSense task and the timer daemon task so
+ * that draining the queue never delays a scan.
+ */
+#define TOUCH_EVENT_TASK_STACK_SIZE_WORDS    (512)
+#define TOUCH_EVENT_TASK_PRIORITY            (1U)
+
+/* With STACK_MONITOR_ENABLE, the consumer task checks the stack high water
+ * marks of the tasks once per interval, and reports the tasks whose free
+ * stack has decreased since the last report.
+ */
+#define TOUCH_EVENT_STACK_CHECK_INTERVAL_MS  (1000U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* The values are also the frame types of the binary telemetry (see
+ * telemetry.h) and must not be changed.
+ */
+typedef enum
+{
+    TOUCH_EVENT_SLIDER_POSITION = 0,    /* value: position */
+    TOUCH_EVENT_SCAN_RATE = 1,          /* arg: transition, value: new interval (ms),
+                                         * data: widget of the previous tier */
+    TOUCH_EVENT_GESTURE = 2,            /* arg: gesture type, value: position,
+                                         * data: velocity */
+    TOUCH_EVENT_AVERAGE_CURRENT = 3,    /* data: modeled average current (nA) */
+    TOUCH_EVENT_TRIGGER_LATENCY = 4,    /* data: max scan trigger latency (us) */
+    TOUCH_EVENT_TOUCH_STATE = 5,        /* arg: widget, value: 1 if touched */
+    TOUCH_EVENT_SENSOR_COUNTS = 6,      /* arg: widget << 4 | sensor, value: raw count,
+                                         * data: difference count */
+    TOUCH_EVENT_DROPPED = 7,            /* data: total number of dropped events */
+    TOUCH_EVENT_STACK_HIGH_WATER = 8,   /* arg: touch_event_stack_task_t,
+                                         * data: minimum free stack (bytes) */
+    TOUCH_EVENT_RUN_TIME = 9            /* arg: runtime_stats_task_t, value: CPU
+                                         * share (0.1 %), data: CPU time (us),
+                                         * both since the previous report */
+} touch_event_type_t;
+
+/* Tasks reported by TOUCH_EVENT_STACK_HIGH_WATER. */
+typedef enum
+{
+    TOUCH_EVENT_STACK_CAPSENSE_TASK = 0,
+    TOUCH_EVENT_STACK_TOUCH_EVENT_TASK = 1,
+    TOUCH_EVENT_STACK_TIMER_TASK = 2,
+    TOUCH_EVENT_STACK_NUM_TASKS = 3
+} touch_event_stack_task_t;
+
+/* Compact binary event. */
+typedef struct
+{
+    uint8_t type;
+    uint8_t arg;
+    uint16_t value;
+    int32_t data;
+    uint32_t timestamp_ms;
+} touch_event_t;
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+extern TaskHandle_t touch_event_task_handle;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool touch_event_post(touch_event_type_t type, uint8_t arg, uint16_t value, int32_t data);
+bool touch_event_get(touch_event_t *event);
+uint32_t touch_event_get_dropped_count(void);
+void touch_event_task(void *arg);
+
+
+#endif /* SOURCE_TOUCH_EVENT_H */
+
+/* [] END OF FILE */
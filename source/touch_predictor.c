@@ -0,0 +1,220 @@
+/******************************************************************************
+* File Name:   touch_predictor.c
+*
+* Description: This file contains function definitions of the touch-activity
+*              predictor. The predictor learns the usage pattern from the touch
+*              sessions detected by process_touch, using an exponential
+*              inter-session gap estimator and a daily usage histogram.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "touch_predictor.h"
+#include "lp_timer.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Histogram bins are halved when one of them reaches this value so that the
+ * histogram follows changes in the usage pattern.
+ */
+#define TOUCH_PREDICTOR_BIN_LIMIT            (UINT16_MAX / 2U)
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: touch_predictor_init
+********************************************************************************
+* Summary: Clears the usage history and starts the clock of the predictor at
+* the LPTimer count now_ticks.
+*
+*******************************************************************************/
+void touch_predictor_init(touch_predictor_t *predictor, uint32_t now_ticks)
+{
+    predictor->last_ticks = now_ticks;
+    predictor->remainder = 0;
+    predictor->time_of_day_ms = 0;
+    predictor->idle_ms = 0;
+    predictor->gap_avg_ms = 0;
+    predictor->num_sessions = 0;
+
+    for (uint32_t i = 0; i < TOUCH_PREDICTOR_NUM_BINS; i++)
+    {
+        predictor->histogram[i] = 0;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: touch_predictor_update
+********************************************************************************
+* Summary: Advances the clock of the predictor to the LPTimer count now_ticks.
+* The elapsed time is the wrap-safe difference to the previous count, and the
+* sub-millisecond remainder is carried over to the next update.
+*
+* Parameters:
+* touch_predictor_t *predictor: Pointer to the predictor state.
+* uint32_t now_ticks: Current LPTimer count (lp_timer_read).
+*
+*******************************************************************************/
+void touch_predictor_update(touch_predictor_t *predictor, uint32_t now_ticks)
+{
+    uint64_t elapsed = (uint64_t)(now_ticks - predictor->last_ticks) * 1000U + predictor->remainder;
+    uint32_t elapsed_ms = (uint32_t)(elapsed / LP_TIMER_FREQ_HZ);
+
+    predictor->last_ticks = now_ticks;
+    predictor->remainder = (uint32_t)(elapsed % LP_TIMER_FREQ_HZ);
+    predictor->time_of_day_ms = (uint32_t)(((uint64_t)predictor->time_of_day_ms + elapsed_ms) %
+                                           TOUCH_PREDICTOR_DAY_MS);
+    predictor->idle_ms = (UINT32_MAX - predictor->idle_ms > elapsed_ms) ?
+                         (predictor->idle_ms + elapsed_ms) : UINT32_MAX;
+}
+
+
+/*******************************************************************************
+* Function Name: touch_predictor_record_touch
+********************************************************************************
+* Summary: Records a touch detected at the time of the last update. If the
+* touch starts a new session, the gap to the previous session updates the gap
+* estimate and the session is counted in the histogram bin of the time of day.
+*
+* Parameters:
+* touch_predictor_t *predictor: Pointer to the predictor state.
+*
+*******************************************************************************/
+void touch_predictor_record_touch(touch_predictor_t *predictor)
+{
+    uint32_t gap_ms = predictor->idle_ms;
+    uint32_t bin = predictor->time_of_day_ms / TOUCH_PREDICTOR_BIN_MS;
+
+    predictor->idle_ms = 0;
+
+    if ((0U != predictor->num_sessions) && (TOUCH_PREDICTOR_SESSION_GAP_MS >= gap_ms))
+    {
+        /* Same session. */
+        return;
+    }
+
+    if (0U == predictor->num_sessions)
+    {
+        predictor->gap_avg_ms = 0;
+    }
+    else if (0U == predictor->gap_avg_ms)
+    {
+        predictor->gap_avg_ms = gap_ms;
+    }
+    else
+    {
+        predictor->gap_avg_ms = predictor->gap_avg_ms -
+                                (predictor->gap_avg_ms >> TOUCH_PREDICTOR_EWMA_SHIFT) +
+                                (gap_ms >> TOUCH_PREDICTOR_EWMA_SHIFT);
+    }
+
+    if (UINT32_MAX > predictor->num_sessions)
+    {
+        predictor->num_sessions++;
+    }
+
+    if (TOUCH_PREDICTOR_BIN_LIMIT <= ++predictor->histogram[bin])
+    {
+        for (uint32_t i = 0; i < TOUCH_PREDICTOR_NUM_BINS; i++)
+        {
+            predictor->histogram[i] >>= 1;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: touch_predictor_is_touch_expected
+********************************************************************************
+* Summary: Returns whether the next touch session is expected soon, i.e. the
+* time since the last touch is within TOUCH_PREDICTOR_LEAD_TIME_MS of the gap
+* estimate and has not yet exceeded twice the estimate.
+*
+*******************************************************************************/
+bool touch_predictor_is_touch_expected(const touch_predictor_t *predictor)
+{
+    uint32_t idle_ms = predictor->idle_ms;
+    uint32_t window_start_ms;
+
+    if ((TOUCH_PREDICTOR_MIN_SESSIONS > predictor->num_sessions) ||
+        (0U == predictor->gap_avg_ms))
+    {
+        return false;
+    }
+
+    window_start_ms = (predictor->gap_avg_ms > TOUCH_PREDICTOR_LEAD_TIME_MS) ?
+                      (predictor->gap_avg_ms - TOUCH_PREDICTOR_LEAD_TIME_MS) : 0U;
+
+    return ((idle_ms >= window_start_ms) && ((idle_ms / 2U) < predictor->gap_avg_ms));
+}
+
+
+/*******************************************************************************
+* Function Name: touch_predictor_is_quiet_period
+********************************************************************************
+* Summary: Returns whether the time of day falls into a histogram bin that has
+* seen less than a quarter of the average number of sessions per bin.
+*
+*******************************************************************************/
+bool touch_predictor_is_quiet_period(const touch_predictor_t *predictor)
+{
+    uint32_t bin = predictor->time_of_day_ms / TOUCH_PREDICTOR_BIN_MS;
+    uint32_t total = 0;
+
+    if (TOUCH_PREDICTOR_MIN_SESSIONS > predictor->num_sessions)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < TOUCH_PREDICTOR_NUM_BINS; i++)
+    {
+        total += predictor->histogram[i];
+    }
+
+    return ((uint32_t)predictor->histogram[bin] * TOUCH_PREDICTOR_NUM_BINS * 4U) < total;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+/******************************************************************************
+* File Name:   touch_predictor.h
+*
+* Description: This file contains the data types and function prototypes of the
+*              touch-activity predictor used by the scan policy.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TOUCH_PREDICTOR_H
+#define SOURCE_TOUCH_PREDICTOR_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* A touch that follows the previous touch by more than this time starts a new
+ * touch session. Only session starts are fed into the model.
+ */
+#define TOUCH_PREDICTOR_SESSION_GAP_MS       (2000U)
+
+/* The usage histogram splits a day into TOUCH_PREDICTOR_NUM_BINS bins of
+ * TOUCH_PREDICTOR_BIN_MS each. Time is counted from power-up since the example
+ * has no calendar time, so the bins follow the daily usage pattern relative to
+ * power-up. The time of day is kept modulo TOUCH_PREDICTOR_DAY_MS, so the bins
+ * stay aligned to the day however long the device runs.
+ */
+#define TOUCH_PREDICTOR_NUM_BINS             (24U)
+#define TOUCH_PREDICTOR_BIN_MS               (3600UL * 1000UL)
+#define TOUCH_PREDICTOR_DAY_MS               (TOUCH_PREDICTOR_NUM_BINS * TOUCH_PREDICTOR_BIN_MS)
+
+/* Minimum number of recorded sessions before predictions are made. */
+#define TOUCH_PREDICTOR_MIN_SESSIONS         (8U)
+
+/* The inter-session gap estimate is an exponential moving average with a
+ * weight of 1/(2^TOUCH_PREDICTOR_EWMA_SHIFT) for the newest gap.
+ */
+#define TOUCH_PREDICTOR_EWMA_SHIFT           (3U)
+
+/* Fast scan is pre-warmed this long before the expected next session. */
+#define TOUCH_PREDICTOR_LEAD_TIME_MS         (5000U)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* The clock of the predictor is advanced from the free-running LPTimer count,
+ * which keeps counting in system deep sleep. The count wraps after about 36
+ * hours; touch_predictor_update must be called more often than that.
+ */
+typedef struct
+{
+    uint32_t last_ticks;            /* LPTimer count at the last update */
+    uint32_t remainder;             /* Ticks x 1000 not yet converted to ms */
+    uint32_t time_of_day_ms;        /* Time since power-up modulo a day */
+    uint32_t idle_ms;               /* Time since the last touch, saturated */
+    uint32_t gap_avg_ms;
+    uint32_t num_sessions;
+    uint16_t histogram[TOUCH_PREDICTOR_NUM_BINS];
+} touch_predictor_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void touch_predictor_init(touch_predictor_t *predictor, uint32_t now_ticks);
+void touch_predictor_update(touch_predictor_t *predictor, uint32_t now_ticks);
+void touch_predictor_record_touch(touch_predictor_t *predictor);
+bool touch_predictor_is_touch_expected(const touch_predictor_t *predictor);
+bool touch_predictor_is_quiet_period(const touch_predictor_t *predictor);
+
+
+#endif /* SOURCE_TOUCH_PREDICTOR_H */
+
+/* [] END OF FILE */
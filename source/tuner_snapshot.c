@@ -0,0 +1,286 @@
+/******************************************************************************
+* File Name:   tuner_snapshot.c
+*
+* Description: This file contains the deep-sleep-capable tuner transport. The
+*              counts of every processed widget are captured into a RAM ring
+*              during normal low-power operation and drained in bursts over
+*              EZI2C when the host asks for them.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cybsp.h"
+#include "cyhal.h"
+#include "cy_pdl.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "tuner_snapshot.h"
+#include "scan_policy.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TUNER_SNAPSHOT_RING_MASK             (TUNER_SNAPSHOT_RING_SIZE - 1U)
+
+#if ((TUNER_SNAPSHOT_RING_SIZE & TUNER_SNAPSHOT_RING_MASK) != 0U)
+#error "TUNER_SNAPSHOT_RING_SIZE must be a power of two."
+#endif
+
+#if (TUNER_SNAPSHOT_RING_SIZE < (TUNER_SNAPSHOT_HOST_POLL_INTERVAL_MS / CAPSENSE_FAST_SCAN_INTERVAL_MS))
+#error "TUNER_SNAPSHOT_RING_SIZE does not hold the snapshots of TUNER_SNAPSHOT_HOST_POLL_INTERVAL_MS."
+#endif
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static cyhal_ezi2c_t tuner_snapshot_ezi2c;
+
+/* The head index is written only by capsense_task and the tail index only by
+ * the EZI2C interrupt. The snapshots are plain memory, so a data memory barrier
+ * (also a compiler barrier) orders them against the indices, as in the event
+ * queue of touch_event.c.
+ */
+static tuner_snapshot_t tuner_snapshot_ring[TUNER_SNAPSHOT_RING_SIZE];
+static volatile uint32_t tuner_snapshot_head;
+static volatile uint32_t tuner_snapshot_tail;
+static volatile uint32_t tuner_snapshot_dropped_count;
+static uint16_t tuner_snapshot_sequence;
+
+static tuner_snapshot_regs_t tuner_snapshot_regs;
+static bool tuner_snapshot_is_draining = false;
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void handle_ezi2c_event(void *callback_arg, cyhal_ezi2c_status_t event);
+static void fill_burst(void);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tuner_snapshot_init
+********************************************************************************
+* Summary: Configures the EZI2C slave that serves the register map. Unlike the
+* CapSense Tuner, the slave is configured to wake the device from deep sleep on
+* an address match, so deep sleep is not locked.
+*
+*******************************************************************************/
+cy_rslt_t tuner_snapshot_init(void)
+{
+    cy_rslt_t result;
+    cyhal_ezi2c_cfg_t ezi2c_cfg = { 0 };
+
+    ezi2c_cfg.data_rate = CYHAL_EZI2C_DATA_RATE_400KHZ;
+    ezi2c_cfg.enable_wake_from_sleep = true;
+    ezi2c_cfg.slave1_cfg.buf = (uint8_t *)&tuner_snapshot_regs;
+    ezi2c_cfg.slave1_cfg.buf_rw_boundary = sizeof(tuner_snapshot_regs.command);
+    ezi2c_cfg.slave1_cfg.buf_size = sizeof(tuner_snapshot_regs);
+    ezi2c_cfg.slave1_cfg.slave_address = TUNER_SNAPSHOT_I2C_ADDRESS;
+    ezi2c_cfg.sub_address_size = CYHAL_EZI2C_SUB_ADDR16_BITS;
+    ezi2c_cfg.two_addresses = false;
+
+    result = cyhal_ezi2c_init(&tuner_snapshot_ezi2c, CYBSP_I2C_SDA, CYBSP_I2C_SCL, NULL, &ezi2c_cfg);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cyhal_ezi2c_register_callback(&tuner_snapshot_ezi2c, handle_ezi2c_event, NULL);
+        cyhal_ezi2c_enable_event(&tuner_snapshot_ezi2c,
+                                 (CYHAL_EZI2C_STATUS_ERR | CYHAL_EZI2C_STATUS_WRITE1),
+                                 TUNER_SNAPSHOT_INTR_PRIORITY, true);
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: tuner_snapshot_capture
+********************************************************************************
+* Summary: Adds the counts and the status of a processed widget to the ring.
+* Never blocks. If the ring is full, the snapshot is dropped and counted.
+*
+* Parameters:
+*  widget_id: widget processed in the current scan
+*  context: CapSense context
+*
+*******************************************************************************/
+void tuner_snapshot_capture(uint32_t widget_id, const cy_stc_capsense_context_t *context)
+{
+    const cy_stc_capsense_widget_config_t *widget_config = &context->ptrWdConfig[widget_id];
+    uint32_t head = tuner_snapshot_head;
+    uint32_t num_sensors = widget_config->numSns;
+    tuner_snapshot_t *snapshot;
+
+    tuner_snapshot_sequence++;
+
+    if ((head - tuner_snapshot_tail) >= TUNER_SNAPSHOT_RING_SIZE)
+    {
+        tuner_snapshot_dropped_count++;
+        return;
+    }
+
+    /* Do not overwrite the entry before the interrupt has released it. */
+    __DMB();
+
+    if (num_sensors > TUNER_SNAPSHOT_MAX_SENSORS)
+    {
+        num_sensors = TUNER_SNAPSHOT_MAX_SENSORS;
+    }
+
+    snapshot = &tuner_snapshot_ring[head & TUNER_SNAPSHOT_RING_MASK];
+    snapshot->timestamp_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+    snapshot->sequence = tuner_snapshot_sequence;
+    snapshot->widget_id = (uint8_t)widget_id;
+    snapshot->status = widget_config->ptrWdContext->status;
+    snapshot->num_sensors = (uint8_t)num_sensors;
+
+    for (uint32_t i = 0; i < num_sensors; i++)
+    {
+        snapshot->raw[i] = widget_config->ptrSnsContext[i].raw;
+        snapshot->baseline[i] = widget_config->ptrSnsContext[i].bsln;
+        snapshot->diff[i] = widget_config->ptrSnsContext[i].diff;
+    }
+
+    /* Publish the entry only after it has been written. */
+    __DMB();
+    tuner_snapshot_head = head + 1U;
+}
+
+
+/*******************************************************************************
+* Function Name: tuner_snapshot_get_dropped_count
+********************************************************************************
+* Summary: Returns the number of snapshots dropped because the ring was full.
+*
+*******************************************************************************/
+uint32_t tuner_snapshot_get_dropped_count(void)
+{
+    return tuner_snapshot_dropped_count;
+}
+
+
+/*******************************************************************************
+* Function Name: handle_ezi2c_event
+********************************************************************************
+* Summary: Executes the command written by the host. Deep sleep is locked from
+* the first drain command until the release command so that the SCB clock runs
+* for the whole session.
+*
+*******************************************************************************/
+static void handle_ezi2c_event(void *callback_arg, cyhal_ezi2c_status_t event)
+{
+    (void)callback_arg;
+
+    if (0U != (CYHAL_EZI2C_STATUS_ERR & event))
+    {
+        return;
+    }
+
+    if (0U != (CYHAL_EZI2C_STATUS_WRITE1 & event))
+    {
+        switch (tuner_snapshot_regs.command)
+        {
+            case TUNER_SNAPSHOT_CMD_DRAIN:
+                if (!tuner_snapshot_is_draining)
+                {
+                    cyhal_syspm_lock_deepsleep();
+                    tuner_snapshot_is_draining = true;
+                }
+                fill_burst();
+                break;
+
+            case TUNER_SNAPSHOT_CMD_RELEASE:
+                if (tuner_snapshot_is_draining)
+                {
+                    cyhal_syspm_unlock_deepsleep();
+                    tuner_snapshot_is_draining = false;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        /* Acknowledge the command. */
+        tuner_snapshot_regs.command = TUNER_SNAPSHOT_CMD_NONE;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: fill_burst
+********************************************************************************
+* Summary: Moves the oldest snapshots from the ring to the burst window.
+*
+*******************************************************************************/
+static void fill_burst(void)
+{
+    uint32_t tail = tuner_snapshot_tail;
+    uint32_t head = tuner_snapshot_head;
+    uint32_t count = 0U;
+
+    /* Read the entries only after the head that published them. */
+    __DMB();
+
+    while ((count < TUNER_SNAPSHOT_BURST_SIZE) && (tail != head))
+    {
+        tuner_snapshot_regs.burst[count] = tuner_snapshot_ring[tail & TUNER_SNAPSHOT_RING_MASK];
+        count++;
+        tail++;
+    }
+
+    /* Release the entries only after they have been read. */
+    __DMB();
+    tuner_snapshot_tail = tail;
+
+    tuner_snapshot_regs.count = (uint8_t)count;
+    tuner_snapshot_regs.pending = (uint16_t)(tuner_snapshot_head - tail);
+    tuner_snapshot_regs.dropped = tuner_snapshot_dropped_count;
+}
+
+
+/* [] END OF FILE */
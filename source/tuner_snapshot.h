@@ -0,0 +1,136 @@
+/******************************************************************************
+* File Name:   tuner_snapshot.h
+*
+* Description: This file contains macros, data types and function prototypes
+*              used by tuner_snapshot.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TUNER_SNAPSHOT_H
+#define SOURCE_TUNER_SNAPSHOT_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cyhal.h"
+#include "cycfg_capsense.h"
+
+#include <stdint.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Longest interval at which the host is expected to drain the ring, e.g.
+ * with tools/ezi2c_loopback.py drain. One snapshot is captured per scan, so
+ * the ring holds the snapshots of this interval at the fastest scan rate
+ * (CAPSENSE_FAST_SCAN_INTERVAL_MS). 64 snapshots take 3840 bytes of RAM.
+ */
+#define TUNER_SNAPSHOT_HOST_POLL_INTERVAL_MS (1000U)
+
+/* Number of entries in the snapshot ring. Must be a power of two. */
+#define TUNER_SNAPSHOT_RING_SIZE             (64U)
+
+/* Number of snapshots returned by one drain command. */
+#define TUNER_SNAPSHOT_BURST_SIZE            (4U)
+
+/* Sensors captured per widget. */
+#define TUNER_SNAPSHOT_MAX_SENSORS           (8U)
+
+#define TUNER_SNAPSHOT_I2C_ADDRESS           (8U)
+
+/* EZI2C interrupt priority. The interrupt does not call FreeRTOS APIs. */
+#define TUNER_SNAPSHOT_INTR_PRIORITY         (7U)
+
+/* Commands written by the host to the command register. The firmware clears
+ * the register when the command has been executed.
+ */
+#define TUNER_SNAPSHOT_CMD_NONE              (0U)
+#define TUNER_SNAPSHOT_CMD_DRAIN             (1U)    /* Lock deep sleep and move the
+                                                      * oldest snapshots to the burst
+                                                      * window. */
+#define TUNER_SNAPSHOT_CMD_RELEASE           (2U)    /* End of the drain session.
+                                                      * Deep sleep is allowed again. */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Counts of one widget after the processing of a scan. */
+typedef struct
+{
+    uint32_t timestamp_ms;
+    uint16_t sequence;
+    uint8_t widget_id;
+    uint8_t status;                                 /* Widget status */
+    uint8_t num_sensors;
+    uint8_t reserved[3];
+    uint16_t raw[TUNER_SNAPSHOT_MAX_SENSORS];
+    uint16_t baseline[TUNER_SNAPSHOT_MAX_SENSORS];
+    uint16_t diff[TUNER_SNAPSHOT_MAX_SENSORS];
+} tuner_snapshot_t;
+
+/* EZI2C register map, little endian. Only the command register is writable.
+ * A drain session is:
+ *  1. Write TUNER_SNAPSHOT_CMD_DRAIN to the command register. The first
+ *     transfer may be NACKed while the device wakes up from deep sleep.
+ *  2. Read the header until the command register reads 0.
+ *  3. Read count snapshots from the burst window.
+ *  4. Repeat from 1 while pending is not 0.
+ *  5. Write TUNER_SNAPSHOT_CMD_RELEASE.
+ */
+typedef struct
+{
+    uint8_t command;
+    uint8_t count;                                  /* Valid snapshots in the burst */
+    uint16_t pending;                               /* Snapshots left in the ring */
+    uint32_t dropped;                               /* Snapshots lost to a full ring */
+    tuner_snapshot_t burst[TUNER_SNAPSHOT_BURST_SIZE];
+} tuner_snapshot_regs_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t tuner_snapshot_init(void);
+void tuner_snapshot_capture(uint32_t widget_id, const cy_stc_capsense_context_t *context);
+uint32_t tuner_snapshot_get_dropped_count(void);
+
+
+#endif /* SOURCE_TUNER_SNAPSHOT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,230 @@
+/******************************************************************************
+* File Name:   tuner_stream.c
+*
+* Description: This file contains the delta encoder of the tuner streaming
+*              window. Only the counts that changed since the previous frame
+*              are stored in a ring of recent frames, which the host drains
+*              through a register window over EZI2C.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "tuner_stream.h"
+
+/* Only the barrier intrinsics of CMSIS; the encoder stays independent of the
+ * PDL.
+ */
+#include "cmsis_compiler.h"
+
+#include <string.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TUNER_STREAM_RING_MASK               (TUNER_STREAM_RING_SIZE - 1U)
+
+#if ((TUNER_STREAM_RING_SIZE & TUNER_STREAM_RING_MASK) != 0U)
+#error "TUNER_STREAM_RING_SIZE must be a power of two."
+#endif
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static uint32_t put_varint(uint8_t *buffer, uint32_t value);
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tuner_stream_init
+********************************************************************************
+* Summary: Empties the ring. The first frame is a key frame.
+*
+*******************************************************************************/
+void tuner_stream_init(tuner_stream_t *stream)
+{
+    memset(stream, 0, sizeof(*stream));
+    stream->is_key_pending = true;
+}
+
+
+/*******************************************************************************
+* Function Name: tuner_stream_add_frame
+********************************************************************************
+* Summary: Encodes the values of a scan as a frame and adds it to the ring.
+* Never blocks. If the ring is full, the frame is dropped and counted, and the
+* next frame is a key frame.
+*
+* Parameters:
+*  sequence: scan counter of the frame
+*  values: raw count, baseline and difference count of every sensor
+*  num_values: number of values, at most TUNER_STREAM_MAX_VALUES
+*
+* Return:
+*  bool: Whether the frame has been added.
+*
+*******************************************************************************/
+bool tuner_stream_add_frame(tuner_stream_t *stream, uint16_t sequence,
+                            const uint16_t *values, uint32_t num_values)
+{
+    uint8_t frame[TUNER_STREAM_MAX_FRAME_SIZE];
+    uint32_t length = TUNER_STREAM_HEADER_SIZE;
+    uint32_t head = stream->head;
+    bool is_key = stream->is_key_pending ||
+                  (stream->frames_since_key >= TUNER_STREAM_KEY_INTERVAL);
+
+    if (num_values > TUNER_STREAM_MAX_VALUES)
+    {
+        num_values = TUNER_STREAM_MAX_VALUES;
+    }
+
+    for (uint32_t i = 0; i < num_values; i++)
+    {
+        int32_t delta = (int32_t)values[i] - (is_key ? 0 : (int32_t)stream->last_values[i]);
+
+        if (is_key || (0 != delta))
+        {
+            frame[length++] = (uint8_t)i;
+            length += put_varint(&frame[length], ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+        }
+    }
+
+    if ((TUNER_STREAM_RING_SIZE - (head - stream->tail)) < length)
+    {
+        stream->dropped_count++;
+        stream->is_key_pending = true;
+        return false;
+    }
+
+    /* Do not overwrite the bytes before the consumer has released them. */
+    __DMB();
+
+    frame[0] = is_key ? TUNER_STREAM_FLAG_KEY : 0U;
+    frame[1] = (uint8_t)sequence;
+    frame[2] = (uint8_t)(sequence >> 8);
+    frame[3] = (uint8_t)(length - TUNER_STREAM_HEADER_SIZE);
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        stream->ring[(head + i) & TUNER_STREAM_RING_MASK] = frame[i];
+    }
+
+    memcpy(stream->last_values, values, num_values * sizeof(values[0]));
+    stream->frames_since_key = is_key ? 0U : (stream->frames_since_key + 1U);
+    stream->is_key_pending = false;
+
+    /* Publish the frame only after it has been written. */
+    __DMB();
+    stream->head = head + length;
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: tuner_stream_fill_window
+********************************************************************************
+* Summary: Moves as many complete frames as fit from the ring to the window.
+*
+*******************************************************************************/
+void tuner_stream_fill_window(tuner_stream_t *stream, tuner_stream_window_t *window)
+{
+    uint32_t tail = stream->tail;
+    uint32_t head = stream->head;
+    uint32_t length = 0U;
+    uint32_t num_frames = 0U;
+
+    /* Read the frames only after the head that published them. */
+    __DMB();
+
+    while (tail != head)
+    {
+        uint32_t frame_length = TUNER_STREAM_HEADER_SIZE +
+                                stream->ring[(tail + 3U) & TUNER_STREAM_RING_MASK];
+
+        if ((length + frame_length) > TUNER_STREAM_WINDOW_SIZE)
+        {
+            break;
+        }
+
+        for (uint32_t i = 0; i < frame_length; i++)
+        {
+            window->data[length++] = stream->ring[tail & TUNER_STREAM_RING_MASK];
+            tail++;
+        }
+        num_frames++;
+    }
+
+    /* Release the frames only after they have been read. */
+    __DMB();
+    stream->tail = tail;
+
+    window->num_frames = (uint8_t)num_frames;
+    window->length = (uint16_t)length;
+    window->dropped = stream->dropped_count;
+}
+
+
+/*******************************************************************************
+* Function Name: put_varint
+********************************************************************************
+* Summary: Writes an unsigned LEB128 varint and returns its length.
+*
+*******************************************************************************/
+static uint32_t put_varint(uint8_t *buffer, uint32_t value)
+{
+    uint32_t length = 0U;
+
+    while (value >= 0x80U)
+    {
+        buffer[length++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+
+    buffer[length++] = (uint8_t)value;
+
+    return length;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,150 @@
+/******************************************************************************
+* File Name:   tuner_stream.h
+*
+* Description: This file contains macros, data types and function prototypes
+*              used by tuner_stream.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TUNER_STREAM_H
+#define SOURCE_TUNER_STREAM_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+/* The stream encoder does not depend on the PDL, HAL, CapSense middleware or
+ * FreeRTOS, in the same way as the telemetry encoder.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frame layout:
+ *
+ *   [flags][sequence: 2 bytes][len][payload: len bytes]
+ *
+ * The sequence is the scan counter of the frame, little endian. The payload
+ * is a sequence of (item, delta) pairs for the values that changed since the
+ * previous frame. item is sensor * 3 + field, where field is 0 for the raw
+ * count, 1 for the baseline and 2 for the difference count, and sensor is the
+ * index in the order of the widgets. delta is the zigzag-encoded LEB128
+ * difference to the previous value of the item. In a key frame
+ * (TUNER_STREAM_FLAG_KEY), all values are present and the deltas are relative
+ * to zero. A key frame follows every frame that had to be dropped because the
+ * ring was full, and every TUNER_STREAM_KEY_INTERVAL frames.
+ */
+#define TUNER_STREAM_FLAG_KEY                (0x01U)
+#define TUNER_STREAM_HEADER_SIZE             (4U)
+
+#define TUNER_STREAM_MAX_SENSORS             (8U)
+#define TUNER_STREAM_NUM_FIELDS              (3U)
+#define TUNER_STREAM_MAX_VALUES              (TUNER_STREAM_MAX_SENSORS * TUNER_STREAM_NUM_FIELDS)
+#define TUNER_STREAM_MAX_FRAME_SIZE          (TUNER_STREAM_HEADER_SIZE + (TUNER_STREAM_MAX_VALUES * 4U))
+
+#define TUNER_STREAM_KEY_INTERVAL            (32U)
+
+/* Second EZI2C address of the tuner slave, which serves the window. */
+#define TUNER_STREAM_I2C_ADDRESS             (9U)
+
+/* Size of the frame ring in bytes. Must be a power of two. */
+#define TUNER_STREAM_RING_SIZE               (512U)
+
+/* Size of the data area of the register window. Holds at least one frame. */
+#define TUNER_STREAM_WINDOW_SIZE             (128U)
+
+/* Command written by the host to the command register of the window. The
+ * firmware clears the register when the window has been refilled.
+ */
+#define TUNER_STREAM_CMD_NONE                (0U)
+#define TUNER_STREAM_CMD_NEXT                (1U)
+
+#if (TUNER_STREAM_WINDOW_SIZE < TUNER_STREAM_MAX_FRAME_SIZE)
+#error "TUNER_STREAM_WINDOW_SIZE must hold a frame of the maximum size."
+#endif
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Register window served on the second EZI2C address, little endian. Only
+ * the command register is writable. The host writes TUNER_STREAM_CMD_NEXT,
+ * reads the header until the command register reads 0, and then reads length
+ * bytes of data, which hold num_frames complete frames. The frames are
+ * removed from the ring when they are moved to the window, so every window
+ * holds only the frames produced since the previous one.
+ */
+typedef struct
+{
+    uint8_t command;
+    uint8_t num_frames;
+    uint16_t length;
+    uint32_t dropped;                               /* Frames lost to a full ring */
+    uint8_t data[TUNER_STREAM_WINDOW_SIZE];
+} tuner_stream_window_t;
+
+typedef struct
+{
+    uint16_t last_values[TUNER_STREAM_MAX_VALUES];
+    uint32_t frames_since_key;
+    bool is_key_pending;
+
+    /* The head index is written only by the producer and the tail index only
+     * by the consumer. The ring bytes are ordered against the indices with
+     * data memory barriers in tuner_stream.c.
+     */
+    uint8_t ring[TUNER_STREAM_RING_SIZE];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t dropped_count;
+} tuner_stream_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void tuner_stream_init(tuner_stream_t *stream);
+bool tuner_stream_add_frame(tuner_stream_t *stream, uint16_t sequence,
+                            const uint16_t *values, uint32_t num_values);
+void tuner_stream_fill_window(tuner_stream_t *stream, tuner_stream_window_t *window);
+
+
+#endif /* SOURCE_TUNER_STREAM_H */
+
+/* [] END OF FILE */
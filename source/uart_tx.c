@@ -0,0 +1,410 @@
+/******************************************************************************
+* File Name:   uart_tx.c
+*
+* Description: This file contains function definitions of the DMA-driven,
+*              double-buffered debug UART transmit path. The task fills one buffer
+*              while DMA drains the other, so that the CPU can sleep while the
+*              bytes are sent. A SysPm callback refuses deep sleep until the
+*              transmission has completed.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "uart_tx.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static uint8_t uart_tx_buffer[2][UART_TX_BUFFER_SIZE];
+
+/* uart_tx_fill_index is the buffer being filled by the task. The other one
+ * is owned by DMA while uart_tx_is_busy is set.
+ */
+static volatile uint32_t uart_tx_fill_index;
+static volatile uint32_t uart_tx_fill_length;
+static volatile bool uart_tx_is_busy;
+
+/* Bytes dropped because a transfer could not be started. */
+static volatile uint32_t uart_tx_dropped_count;
+
+/* Task waiting in uart_tx_flush, notified when the last transfer is done. */
+static TaskHandle_t volatile uart_tx_flush_task;
+
+/* uart_tx_printf is called from a single task only. */
+static char uart_tx_line[UART_TX_LINE_SIZE];
+
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void start_transfer(void);
+static void uart_tx_callback(void *callback_arg, cyhal_uart_event_t event);
+static cy_en_syspm_status_t uart_tx_deep_sleep_cb(cy_stc_syspm_callback_params_t *callback_params,
+                                                  cy_en_syspm_callback_mode_t mode);
+
+static cy_stc_syspm_callback_params_t uart_tx_callback_params =
+{
+    .base       = NULL,
+    .context    = NULL
+};
+
+static cy_stc_syspm_callback_t uart_tx_deep_sleep_callback =
+{
+    uart_tx_deep_sleep_cb,
+    CY_SYSPM_DEEPSLEEP,
+    0,
+    &uart_tx_callback_params,
+    NULL,
+    NULL
+};
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: uart_tx_init
+********************************************************************************
+* Summary: Switches the retarget-io UART to DMA transfers and registers the
+* transmit-done callback and the deep sleep callback. Must be called after
+* cy_retarget_io_init.
+*
+* Return:
+* cy_rslt_t: Result of the HAL calls.
+*
+*******************************************************************************/
+cy_rslt_t uart_tx_init(void)
+{
+    cy_rslt_t result;
+
+    result = cyhal_uart_set_async_mode(&cy_retarget_io_uart_obj, CYHAL_ASYNC_DMA,
+                                       CYHAL_DMA_PRIORITY_DEFAULT);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cyhal_uart_register_callback(&cy_retarget_io_uart_obj, uart_tx_callback, NULL);
+        cyhal_uart_enable_event(&cy_retarget_io_uart_obj, CYHAL_UART_IRQ_TX_DONE,
+                                UART_TX_INTR_PRIORITY, true);
+
+        Cy_SysPm_RegisterCallback(&uart_tx_deep_sleep_callback);
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_write
+********************************************************************************
+* Summary: Copies data into the fill buffer and starts the transfer if DMA is
+* idle. Waits for a buffer swap only if the fill buffer is full.
+*
+* Parameters:
+* const char *data: Data to be sent.
+* uint32_t length: Number of bytes.
+*
+*******************************************************************************/
+void uart_tx_write(const char *data, uint32_t length)
+{
+    uint32_t interrupt_state;
+    uint32_t chunk;
+
+    while (0U != length)
+    {
+        interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+        chunk = UART_TX_BUFFER_SIZE - uart_tx_fill_length;
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+
+        memcpy(&uart_tx_buffer[uart_tx_fill_index][uart_tx_fill_length], data, chunk);
+        uart_tx_fill_length += chunk;
+
+        if (!uart_tx_is_busy)
+        {
+            start_transfer();
+        }
+
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+        data += chunk;
+        length -= chunk;
+
+        if (0U != length)
+        {
+            /* Both buffers are in use. Sleep until DMA releases one. */
+            vTaskDelay(1);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_printf
+********************************************************************************
+* Summary: Formats a line of at most UART_TX_LINE_SIZE - 1 characters and sends
+* it with uart_tx_write.
+*
+*******************************************************************************/
+void uart_tx_printf(const char *format, ...)
+{
+    va_list args;
+    int length;
+
+    va_start(args, format);
+    length = vsnprintf(uart_tx_line, sizeof(uart_tx_line), format, args);
+    va_end(args);
+
+    if (length > 0)
+    {
+        if ((uint32_t)length >= sizeof(uart_tx_line))
+        {
+            length = (int)(sizeof(uart_tx_line) - 1U);
+        }
+
+        uart_tx_write(uart_tx_line, (uint32_t)length);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_flush
+********************************************************************************
+* Summary: Waits until all the buffered data has been sent. Call it before
+* printing with the blocking retarget-io printf.
+*
+* The task blocks on its notification until the transmit-done interrupt of the
+* last transfer sets UART_TX_FLUSH_NOTIFY_BIT. A notification value written by
+* another source while waiting (e.g. a scan request to capsense_task) is posted
+* again with eSetValueWithOverwrite before returning, so it is not lost.
+*
+*******************************************************************************/
+void uart_tx_flush(void)
+{
+    uint32_t interrupt_state;
+    uint32_t notified_value;
+    uint32_t other_value = 0U;
+    bool is_sent = false;
+
+    while (!is_sent)
+    {
+        interrupt_state = Cy_SysLib_EnterCriticalSection();
+        is_sent = (!uart_tx_is_busy) && (0U == uart_tx_fill_length);
+        uart_tx_flush_task = is_sent ? NULL : xTaskGetCurrentTaskHandle();
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+        if (!is_sent)
+        {
+            /* The stale value is cleared only if no notification is pending. */
+            xTaskNotifyWait(UINT32_MAX, UART_TX_FLUSH_NOTIFY_BIT, &notified_value, portMAX_DELAY);
+            if (0U != (notified_value & ~UART_TX_FLUSH_NOTIFY_BIT))
+            {
+                other_value = notified_value & ~UART_TX_FLUSH_NOTIFY_BIT;
+            }
+        }
+    }
+
+    if (0U != other_value)
+    {
+        xTaskNotify(xTaskGetCurrentTaskHandle(), other_value, eSetValueWithOverwrite);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_idle_sleep
+********************************************************************************
+* Summary: Low-power idle hook (portSUPPRESS_TICKS_AND_SLEEP) with
+* UART_TX_DMA_ENABLE. Calls vApplicationSleep of the RTOS abstraction library
+* when no data is left to send. Otherwise, uart_tx_deep_sleep_cb would refuse
+* deep sleep, vApplicationSleep would return at once, and the idle task would
+* retry deep sleep in a busy loop until the last byte is sent. The CPU sleeps
+* until the next interrupt instead. The tick is not suppressed, so the RTOS
+* time needs no correction.
+*
+* Parameters:
+* uint32_t expected_idle_ticks: Number of ticks until the next task is due.
+*
+*******************************************************************************/
+#if (configUSE_TICKLESS_IDLE != 0)
+void uart_tx_idle_sleep(uint32_t expected_idle_ticks)
+{
+    /* A pending interrupt ends the sleep even with interrupts disabled, so the
+     * transmit-done interrupt cannot be missed between the check and WFI.
+     */
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    if (uart_tx_is_busy || (0U != uart_tx_fill_length) ||
+        cyhal_uart_is_tx_active(&cy_retarget_io_uart_obj))
+    {
+        (void)cyhal_syspm_sleep();
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+    }
+    else
+    {
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+        vApplicationSleep(expected_idle_ticks);
+    }
+}
+#endif /* configUSE_TICKLESS_IDLE */
+
+
+/*******************************************************************************
+* Function Name: uart_tx_get_dropped_count
+********************************************************************************
+* Summary: Returns the number of bytes dropped because a transfer could not be
+* started.
+*
+*******************************************************************************/
+uint32_t uart_tx_get_dropped_count(void)
+{
+    return uart_tx_dropped_count;
+}
+
+
+/*******************************************************************************
+* Function Name: start_transfer
+********************************************************************************
+* Summary: Hands the fill buffer over to DMA and starts filling the other one.
+* Must be called with interrupts disabled.
+*
+*******************************************************************************/
+static void start_transfer(void)
+{
+    uint32_t index = uart_tx_fill_index;
+    uint32_t length = uart_tx_fill_length;
+
+    if (0U == length)
+    {
+        uart_tx_is_busy = false;
+        return;
+    }
+
+    uart_tx_fill_index = index ^ 1U;
+    uart_tx_fill_length = 0U;
+
+    if (CY_RSLT_SUCCESS == cyhal_uart_write_async(&cy_retarget_io_uart_obj,
+                                                  uart_tx_buffer[index], length))
+    {
+        uart_tx_is_busy = true;
+    }
+    else
+    {
+        /* The data is dropped. Do not stall the writers. */
+        uart_tx_dropped_count += length;
+        uart_tx_is_busy = false;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_callback
+********************************************************************************
+* Summary: UART event callback. Starts the transfer of the buffer that has been
+* filled while the previous one was being sent, or wakes the task waiting in
+* uart_tx_flush when there is nothing left to send.
+*
+*******************************************************************************/
+static void uart_tx_callback(void *callback_arg, cyhal_uart_event_t event)
+{
+    BaseType_t is_higher_priority_task_woken = pdFALSE;
+    TaskHandle_t flush_task;
+
+    (void)callback_arg;
+
+    if (0U != ((uint32_t)event & (uint32_t)CYHAL_UART_IRQ_TX_DONE))
+    {
+        start_transfer();
+
+        flush_task = uart_tx_flush_task;
+        if ((!uart_tx_is_busy) && (NULL != flush_task))
+        {
+            uart_tx_flush_task = NULL;
+            xTaskNotifyFromISR(flush_task, UART_TX_FLUSH_NOTIFY_BIT, eSetBits,
+                               &is_higher_priority_task_woken);
+            portYIELD_FROM_ISR(is_higher_priority_task_woken);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_deep_sleep_cb
+********************************************************************************
+* Summary: Refuses deep sleep while there is data in the buffers, the DMA
+* transfer, or the TX FIFO. uart_tx_idle_sleep does not attempt deep sleep in
+* that case; the callback still protects entries to deep sleep from elsewhere.
+*
+*******************************************************************************/
+static cy_en_syspm_status_t uart_tx_deep_sleep_cb(cy_stc_syspm_callback_params_t *callback_params,
+                                                  cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t status = CY_SYSPM_SUCCESS;
+
+    (void)callback_params;
+
+    if (CY_SYSPM_CHECK_READY == mode)
+    {
+        if (uart_tx_is_busy || (0U != uart_tx_fill_length) ||
+            cyhal_uart_is_tx_active(&cy_retarget_io_uart_obj))
+        {
+            status = CY_SYSPM_FAIL;
+        }
+    }
+
+    return status;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name:   uart_tx.h
+*
+* Description: This file contains macros and function prototypes of the
+*              DMA-driven, double-buffered debug UART transmit path.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_UART_TX_H
+#define SOURCE_UART_TX_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cyhal.h"
+
+#include <stdint.h>
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of each of the two transmit buffers. */
+#define UART_TX_BUFFER_SIZE                  (256U)
+
+/* Size of the line formatted by uart_tx_printf. */
+#define UART_TX_LINE_SIZE                    (128U)
+
+#define UART_TX_INTR_PRIORITY                (7U)
+
+/* Notification bit set by the transmit-done interrupt to wake the task waiting
+ * in uart_tx_flush. The calling task must not use it for anything else.
+ */
+#define UART_TX_FLUSH_NOTIFY_BIT             (0x80000000UL)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t uart_tx_init(void);
+void uart_tx_write(const char *data, uint32_t length);
+void uart_tx_printf(const char *format, ...);
+void uart_tx_flush(void);
+uint32_t uart_tx_get_dropped_count(void);
+void uart_tx_idle_sleep(uint32_t expected_idle_ticks);
+
+
+#endif /* SOURCE_UART_TX_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,179 @@
+/******************************************************************************
+* File Name:   wake_coalesce.c
+*
+* Description: This file contains the timer slack API that aligns the wake-ups
+*              of other tasks with the periodic scan wake-ups. Every wake-up
+*              from deep sleep costs the fixed deep-sleep entry/exit energy
+*              (CY_CFG_PWR_DEEPSLEEP_LATENCY), so a wake-up that can be
+*              delayed by up to its slack is moved to the next scan wake-up in
+*              that window and both are served by a single exit from deep
+*              sleep.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "wake_coalesce.h"
+
+
+/*******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static wake_coalesce_anchor_t wake_coalesce_anchor = NULL;
+static uint32_t wake_coalesce_anchor_freq_hz = configTICK_RATE_HZ;
+static volatile uint32_t wake_coalesce_aligned_count = 0U;
+
+
+/*******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: wake_coalesce_set_anchor
+********************************************************************************
+* Summary: Registers the function that returns the next periodic wake-up, and
+* the frequency of the units it returns. The CapSense task registers the scan
+* timer when it starts it.
+*
+*******************************************************************************/
+void wake_coalesce_set_anchor(wake_coalesce_anchor_t anchor, uint32_t freq_hz)
+{
+    wake_coalesce_anchor_freq_hz = freq_hz;
+    wake_coalesce_anchor = anchor;
+}
+
+
+/*******************************************************************************
+* Function Name: wake_coalesce_align
+********************************************************************************
+* Summary: Returns the delay of a wake-up aligned with a periodic wake-up. The
+* earliest periodic wake-up in the window [delay, delay + slack] is returned if
+* there is one, otherwise the delay is returned unchanged. A wake-up is never
+* moved earlier than requested.
+*
+* All times are in the same units, those of the periodic wake-up, in which its
+* period is exact.
+*
+* Parameters:
+*  delay: requested delay
+*  slack: tolerated additional delay
+*  time_to_next: time to the next periodic wake-up
+*  period: period of the periodic wake-ups, 0 if it is a one-shot
+*
+*******************************************************************************/
+uint32_t wake_coalesce_align(uint32_t delay, uint32_t slack,
+                             uint32_t time_to_next, uint32_t period)
+{
+    uint32_t aligned = time_to_next;
+
+    if ((aligned < delay) && (0U != period))
+    {
+        /* First periodic wake-up at or after the requested delay */
+        aligned += ((delay - aligned + period - 1U) / period) * period;
+    }
+
+    return ((aligned >= delay) && ((aligned - delay) <= slack)) ? aligned : delay;
+}
+
+
+/*******************************************************************************
+* Function Name: wake_coalesce_get_delay
+********************************************************************************
+* Summary: Returns the delay of a wake-up aligned with the next scan wake-up
+* within the slack.
+*
+* The alignment is done in the units of the anchor and converted to ticks
+* once, because a period that is not a whole number of ticks would otherwise
+* be truncated, and the error would add up over the periods within the slack.
+* The requested window is rounded down and the aligned delay is rounded up to
+* a tick, so that the task wakes up while the scan is in progress rather than
+* just before it.
+*
+* Parameters:
+*  delay: requested delay in ticks
+*  slack: tolerated additional delay in ticks
+*
+*******************************************************************************/
+TickType_t wake_coalesce_get_delay(TickType_t delay, TickType_t slack)
+{
+    uint32_t freq_hz = wake_coalesce_anchor_freq_hz;
+    uint32_t time_to_next;
+    uint32_t period;
+    uint32_t delay_units;
+    uint32_t limit_units;
+    uint32_t aligned_units;
+    TickType_t aligned = delay;
+
+    if ((NULL != wake_coalesce_anchor) && (0U != slack) &&
+        wake_coalesce_anchor(&time_to_next, &period))
+    {
+        delay_units = (uint32_t)(((uint64_t)delay * freq_hz) / configTICK_RATE_HZ);
+        limit_units = (uint32_t)(((uint64_t)(delay + slack) * freq_hz) / configTICK_RATE_HZ);
+        aligned_units = wake_coalesce_align(delay_units, limit_units - delay_units,
+                                            time_to_next, period);
+
+        if (aligned_units != delay_units)
+        {
+            aligned = (TickType_t)((((uint64_t)aligned_units * configTICK_RATE_HZ) + freq_hz - 1U) /
+                                   freq_hz);
+            if (aligned < delay)
+            {
+                aligned = delay;
+            }
+            wake_coalesce_aligned_count++;
+        }
+    }
+
+    return aligned;
+}
+
+
+/*******************************************************************************
+* Function Name: wake_coalesce_get_aligned_count
+********************************************************************************
+* Summary: Returns the number of wake-ups that were aligned with a scan
+* wake-up.
+*
+*******************************************************************************/
+uint32_t wake_coalesce_get_aligned_count(void)
+{
+    return wake_coalesce_aligned_count;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,78 @@
+/******************************************************************************
+* File Name:   wake_coalesce.h
+*
+* Description: This file contains macros, data types and function prototypes
+*              used by wake_coalesce.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2020-2021, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_WAKE_COALESCE_H
+#define SOURCE_WAKE_COALESCE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Returns the time from now to the next periodic wake-up of the system (the
+ * scan timer) and its period, in the units of the timer behind it, e.g.
+ * LPTimer ticks. Returns false if no periodic wake-up is scheduled.
+ */
+typedef bool (*wake_coalesce_anchor_t)(uint32_t *time_to_next, uint32_t *period);
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void wake_coalesce_set_anchor(wake_coalesce_anchor_t anchor, uint32_t freq_hz);
+uint32_t wake_coalesce_align(uint32_t delay, uint32_t slack,
+                             uint32_t time_to_next, uint32_t period);
+TickType_t wake_coalesce_get_delay(TickType_t delay, TickType_t slack);
+uint32_t wake_coalesce_get_aligned_count(void);
+
+
+#endif /* SOURCE_WAKE_COALESCE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,711 @@
+#!/usr/bin/env python3
+"""EZI2C slave emulator over a Unix domain socket.
+
+Stands in for the EZI2C slave configured in initialize_capsense_tuner so that
+the tuner path can be exercised and benchmarked on a Linux host without a
+KitProg bridge. The emulator keeps one buffer per slave address with the EZI2C
+semantics used by the firmware:
+
+  - 16-bit sub-addresses (CYHAL_EZI2C_SUB_ADDR16_BITS), sent MSB first.
+  - A write sets the base sub-address of the slave and writes its data from
+    there. A write without data only sets the base.
+  - A read carries no sub-address; it starts at the base sub-address set by
+    the last write to the slave, so a read at an arbitrary offset is a write
+    of the sub-address followed by a read.
+  - Writes at or above the read/write boundary are ignored.
+  - Reads past the end of the buffer return 0xFF.
+  - A completed host write is reported to the device as a WRITE1/WRITE2
+    event with the written bytes.
+
+Usage:
+    ezi2c_loopback.py serve  [--socket PATH] [--demo] [--realtime]
+    ezi2c_loopback.py bench  [--socket PATH] [--mode full|stream] [--duration S]
+    ezi2c_loopback.py drain  [--socket PATH] [--interval S] [--duration S] [-v]
+    ezi2c_loopback.py read   [--socket PATH] ADDRESS SUB_ADDRESS LENGTH
+    ezi2c_loopback.py write  [--socket PATH] ADDRESS SUB_ADDRESS [BYTE ...]
+
+Socket protocol (little endian). Every request is
+    [op: 1][address: 1][sub_address: 2][length: 2][data: length]
+and is answered by
+    [status: 1][length: 2][data: length]
+with status 0 (ACK), 1 (NACK, no slave at the address) or 2 (bad request).
+
+Host ops:
+    0x01 WRITE   set the base sub-address to sub_address and write the data
+    0x02 READ    read length bytes from the base sub-address; sub_address
+                 must be 0
+Device ops (the firmware side, e.g. a host simulation of capsense_task):
+    0x10 CONFIG    create the buffer: length = size, sub_address = rw boundary
+    0x11 PUBLISH   write the data at offset sub_address, atomically with
+                   respect to the host transactions and ignoring the boundary
+    0x12 SUBSCRIBE receive the host write events on this connection
+Events sent to the subscribers, distinguished by the first byte:
+    [0x80][address: 1][sub_address: 2][length: 2][data: length]
+
+--demo attaches a built-in device that emulates the firmware: a tuner map at
+address 8 that is republished at every scan, and the streaming window of
+source/tuner_stream.h at address 9. The frames are encoded by
+source/tuner_stream.c itself, loaded from the shared library built by
+`make -C host_sim lib`. bench compares reading the whole map with
+draining the delta-compressed stream, and reports the bus time modeled at
+400 kHz next to the measured round-trip latency of the socket.
+
+--demo-snapshot attaches an emulation of the snapshot ring of
+source/tuner_snapshot.h at address 8 instead. drain runs the drain session of
+that header against it, or against the firmware built with
+TUNER_SNAPSHOT_ENABLE behind a bridge on the socket, once per interval, and
+reports the snapshots received, the sequence numbers missed, and the largest
+backlog against the ring size.
+"""
+
+import argparse
+import ctypes
+import os
+import random
+import socket
+import socketserver
+import struct
+import sys
+import threading
+import time
+
+DEFAULT_SOCKET = "/tmp/ezi2c.sock"
+
+OP_WRITE = 0x01
+OP_READ = 0x02
+OP_CONFIG = 0x10
+OP_PUBLISH = 0x11
+OP_SUBSCRIBE = 0x12
+EVENT_WRITE = 0x80
+
+STATUS_ACK = 0
+STATUS_NACK = 1
+STATUS_BAD_REQUEST = 2
+
+REQUEST = struct.Struct("<BBHH")
+RESPONSE = struct.Struct("<BH")
+
+BUS_RATE_HZ = 400000
+
+# Tuner slave addresses in source/capsense.c and source/tuner_stream.h
+TUNER_I2C_ADDRESS = 8
+TUNER_STREAM_I2C_ADDRESS = 9
+
+# source/tuner_stream.h
+TUNER_STREAM_FLAG_KEY = 0x01
+TUNER_STREAM_HEADER_SIZE = 4
+TUNER_STREAM_WINDOW_SIZE = 128
+TUNER_STREAM_CMD_NEXT = 1
+WINDOW_HEADER = struct.Struct("<BBHI")
+
+DEFAULT_ENCODER_LIB = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir,
+                                   "host_sim", "build", "libtuner_stream.so")
+
+# source/tuner_snapshot.h
+TUNER_SNAPSHOT_I2C_ADDRESS = 8
+TUNER_SNAPSHOT_HOST_POLL_INTERVAL_MS = 1000
+TUNER_SNAPSHOT_RING_SIZE = 64
+TUNER_SNAPSHOT_BURST_SIZE = 4
+TUNER_SNAPSHOT_MAX_SENSORS = 8
+TUNER_SNAPSHOT_CMD_DRAIN = 1
+TUNER_SNAPSHOT_CMD_RELEASE = 2
+SNAPSHOT_HEADER = struct.Struct("<BBHI")
+SNAPSHOT = struct.Struct("<IHBBB3x%dH%dH%dH" % ((TUNER_SNAPSHOT_MAX_SENSORS,) * 3))
+
+# CAPSENSE_FAST_SCAN_INTERVAL_MS in source/scan_policy.h
+FAST_SCAN_HZ = 50.0
+
+
+def bus_bytes(num_bytes, is_read):
+    """Returns the bytes that a transaction transfers after the address byte:
+    the 2 sub-address bytes of a write, and the data."""
+    return num_bytes + (0 if is_read else 2)
+
+
+def bus_time(num_bytes, is_read):
+    """Returns the time in seconds that a transaction occupies a 400 kHz bus:
+    start, address, (2 sub-address bytes for a write), data, stop. Every byte
+    takes 9 clocks including the ACK."""
+    clocks = 1 + 9 + 9 * bus_bytes(num_bytes, is_read) + 1
+    return clocks / BUS_RATE_HZ
+
+
+class Ezi2cSlave:
+    """Buffers of the slave addresses with the EZI2C access semantics."""
+
+    def __init__(self, realtime=False):
+        self.buffers = {}
+        self.lock = threading.Lock()
+        self.listeners = []
+        self.realtime = realtime
+        self.bus_seconds = 0.0
+        self.transactions = 0
+
+    def config(self, address, size, rw_boundary):
+        with self.lock:
+            # Buffer, read/write boundary, and base sub-address.
+            self.buffers[address] = [bytearray(size), min(rw_boundary, size), 0]
+
+    def publish(self, address, offset, data):
+        with self.lock:
+            buffer = self.buffers[address][0]
+            buffer[offset:offset + len(data)] = data[:max(0, len(buffer) - offset)]
+
+    def fetch(self, address, offset, length):
+        with self.lock:
+            return bytes(self.buffers[address][0][offset:offset + length])
+
+    def _account(self, num_bytes, is_read):
+        duration = bus_time(num_bytes, is_read)
+        self.bus_seconds += duration
+        self.transactions += 1
+        if self.realtime:
+            time.sleep(duration)
+
+    def write(self, address, sub_address, data):
+        """Host write. Returns False if no slave answers at the address."""
+        with self.lock:
+            if address not in self.buffers:
+                return False
+            buffer, rw_boundary, _ = self.buffers[address]
+            self.buffers[address][2] = sub_address
+            end = min(sub_address + len(data), rw_boundary)
+            if sub_address < end:
+                buffer[sub_address:end] = data[:end - sub_address]
+            self._account(len(data), False)
+        if data:
+            for listener in list(self.listeners):
+                listener(address, sub_address, bytes(data))
+        return True
+
+    def read(self, address, length):
+        """Host read from the base sub-address. Returns None if no slave
+        answers at the address."""
+        with self.lock:
+            if address not in self.buffers:
+                return None
+            buffer, _, sub_address = self.buffers[address]
+            data = bytes(buffer[sub_address:sub_address + length])
+            data += b"\xff" * (length - len(data))
+            self._account(length, True)
+        return data
+
+
+class RequestHandler(socketserver.BaseRequestHandler):
+    """Serves the requests of one connection."""
+
+    def setup(self):
+        self.send_lock = threading.Lock()
+        self.listener = None
+
+    def send(self, data):
+        with self.send_lock:
+            self.request.sendall(data)
+
+    def on_write(self, address, sub_address, data):
+        try:
+            self.send(REQUEST.pack(EVENT_WRITE, address, sub_address, len(data)) + data)
+        except OSError:
+            pass
+
+    def handle(self):
+        slave = self.server.slave
+        try:
+            while True:
+                header = recv_exact(self.request, REQUEST.size)
+                if header is None:
+                    break
+                op, address, sub_address, length = REQUEST.unpack(header)
+                data = b""
+                if op != OP_READ and length:
+                    data = recv_exact(self.request, length)
+                    if data is None:
+                        break
+
+                status, reply = STATUS_ACK, b""
+                if op == OP_WRITE:
+                    if not slave.write(address, sub_address, data):
+                        status = STATUS_NACK
+                elif op == OP_READ:
+                    if sub_address != 0:
+                        status = STATUS_BAD_REQUEST
+                    else:
+                        reply = slave.read(address, length)
+                        if reply is None:
+                            status, reply = STATUS_NACK, b""
+                elif op == OP_CONFIG:
+                    slave.config(address, length, sub_address)
+                elif op == OP_PUBLISH:
+                    if address in slave.buffers:
+                        slave.publish(address, sub_address, data)
+                    else:
+                        status = STATUS_NACK
+                elif op == OP_SUBSCRIBE:
+                    if self.listener is None:
+                        self.listener = self.on_write
+                        slave.listeners.append(self.listener)
+                else:
+                    status = STATUS_BAD_REQUEST
+
+                self.send(RESPONSE.pack(status, len(reply)) + reply)
+        except OSError:
+            pass
+
+    def finish(self):
+        if self.listener is not None:
+            self.server.slave.listeners.remove(self.listener)
+
+
+class Server(socketserver.ThreadingMixIn, socketserver.UnixStreamServer):
+    daemon_threads = True
+
+
+def recv_exact(sock, length):
+    data = bytearray()
+    while len(data) < length:
+        chunk = sock.recv(length - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return bytes(data)
+
+
+class Client:
+    """Host side of the socket protocol."""
+
+    def __init__(self, path):
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.sock.connect(path)
+        self.bus_seconds = 0.0
+        self.bus_bytes = 0
+
+    def _account(self, num_bytes, is_read):
+        self.bus_seconds += bus_time(num_bytes, is_read)
+        self.bus_bytes += bus_bytes(num_bytes, is_read)
+
+    def _request(self, op, address, sub_address, length, data=b""):
+        self.sock.sendall(REQUEST.pack(op, address, sub_address, length) + data)
+        while True:
+            status, length = RESPONSE.unpack(recv_exact(self.sock, RESPONSE.size))
+            if status != EVENT_WRITE:
+                break
+            # Event on a subscribed connection: skip the rest of its header
+            # and its data.
+            rest = recv_exact(self.sock, REQUEST.size - RESPONSE.size)
+            recv_exact(self.sock, struct.unpack("<H", rest[-2:])[0])
+        reply = recv_exact(self.sock, length) if length else b""
+        if status == STATUS_NACK:
+            raise IOError("NACK from address 0x%02X" % address)
+        if status != STATUS_ACK:
+            raise IOError("bad request")
+        return reply
+
+    def write(self, address, sub_address, data):
+        """Sets the base sub-address and writes the data from there."""
+        self._request(OP_WRITE, address, sub_address, len(data), bytes(data))
+        self._account(len(data), False)
+
+    def read_base(self, address, length):
+        """Reads from the base sub-address set by the last write."""
+        data = self._request(OP_READ, address, 0, length)
+        self._account(length, True)
+        return data
+
+    def read(self, address, sub_address, length):
+        """Sets the base sub-address and reads from there."""
+        self.write(address, sub_address, b"")
+        return self.read_base(address, length)
+
+
+class TunerStreamEncoder:
+    """The encoder of source/tuner_stream.c, loaded from the shared library
+    built by `make -C host_sim lib`."""
+
+    def __init__(self, library_path):
+        if not os.path.isfile(library_path):
+            raise IOError("%s not found; build it with make -C host_sim lib" % library_path)
+        self.lib = ctypes.CDLL(library_path)
+        self.lib.tuner_stream_add_frame.argtypes = [ctypes.c_void_p, ctypes.c_uint16,
+                                                    ctypes.POINTER(ctypes.c_uint16),
+                                                    ctypes.c_uint32]
+        self.lib.tuner_stream_add_frame.restype = ctypes.c_bool
+        self.stream = ctypes.create_string_buffer(self.lib.tuner_stream_lib_get_stream_size())
+        self.window = ctypes.create_string_buffer(self.lib.tuner_stream_lib_get_window_size())
+        self.lib.tuner_stream_init(self.stream)
+
+    def add_frame(self, sequence, values):
+        return self.lib.tuner_stream_add_frame(self.stream, sequence & 0xFFFF,
+                                               (ctypes.c_uint16 * len(values))(*values),
+                                               len(values))
+
+    def fill_window(self):
+        self.lib.tuner_stream_fill_window(self.stream, self.window)
+        return self.window.raw
+
+
+def decode_stream(data, values):
+    """Decodes the frames of a window into values (updated in place) and
+    returns the list of (sequence, is_key) of the frames."""
+    frames = []
+    position = 0
+    while position < len(data):
+        flags, sequence, length = data[position], data[position + 1] | (data[position + 2] << 8), \
+            data[position + 3]
+        position += TUNER_STREAM_HEADER_SIZE
+        end = position + length
+        if flags & TUNER_STREAM_FLAG_KEY:
+            values.clear()
+        while position < end:
+            item = data[position]
+            position += 1
+            value, shift = 0, 0
+            while True:
+                byte = data[position]
+                position += 1
+                value |= (byte & 0x7F) << shift
+                shift += 7
+                if not byte & 0x80:
+                    break
+            delta = (value >> 1) ^ -(value & 1)
+            values[item] = (values.get(item, 0) + delta) & 0xFFFF
+        frames.append((sequence, bool(flags & TUNER_STREAM_FLAG_KEY)))
+    return frames
+
+
+class DemoDevice:
+    """Emulates the firmware side: republishes a tuner map at every scan and
+    serves the streaming window."""
+
+    def __init__(self, slave, map_size, num_sensors, scan_hz, encoder_lib):
+        self.slave = slave
+        self.map_size = map_size
+        self.num_sensors = num_sensors
+        self.period = 1.0 / scan_hz
+        self.encoder = TunerStreamEncoder(encoder_lib)
+        self.lock = threading.Lock()
+        self.values = [random.randint(900, 1100) for _ in range(num_sensors)]
+        slave.config(TUNER_I2C_ADDRESS, map_size, map_size)
+        slave.config(TUNER_STREAM_I2C_ADDRESS, WINDOW_HEADER.size + TUNER_STREAM_WINDOW_SIZE, 1)
+        slave.listeners.append(self.on_write)
+
+    def on_write(self, address, sub_address, data):
+        if address == TUNER_STREAM_I2C_ADDRESS and sub_address == 0 and \
+                data[0] == TUNER_STREAM_CMD_NEXT:
+            with self.lock:
+                window = self.encoder.fill_window()
+            self.slave.publish(TUNER_STREAM_I2C_ADDRESS, 0, window)
+
+    def run(self):
+        sequence = 0
+        while True:
+            sequence = (sequence + 1) & 0xFFFF
+            for i in range(self.num_sensors):
+                if random.random() < 0.3:
+                    self.values[i] = max(0, min(0xFFFF, self.values[i] + random.randint(-8, 8)))
+            stream_values = []
+            for raw in self.values:
+                stream_values += [raw, 1000, max(0, raw - 1000)]
+            # The map starts with the scan counter, like the common context.
+            frame = struct.pack("<H", sequence) + struct.pack("<%dH" % len(stream_values),
+                                                              *stream_values)
+            self.slave.publish(TUNER_I2C_ADDRESS, 0, frame[:self.map_size])
+            with self.lock:
+                self.encoder.add_frame(sequence, stream_values)
+            time.sleep(self.period)
+
+
+class SnapshotDemoDevice:
+    """Emulates the firmware built with TUNER_SNAPSHOT_ENABLE: captures one
+    snapshot per scan into the ring and executes the drain commands."""
+
+    def __init__(self, slave, num_sensors, scan_hz):
+        self.slave = slave
+        self.num_sensors = min(num_sensors, TUNER_SNAPSHOT_MAX_SENSORS)
+        self.period = 1.0 / scan_hz
+        self.lock = threading.Lock()
+        self.ring = []
+        self.sequence = 0
+        self.dropped = 0
+        self.values = [random.randint(900, 1100) for _ in range(self.num_sensors)]
+        slave.config(TUNER_SNAPSHOT_I2C_ADDRESS,
+                     SNAPSHOT_HEADER.size + TUNER_SNAPSHOT_BURST_SIZE * SNAPSHOT.size, 1)
+        slave.listeners.append(self.on_write)
+
+    def on_write(self, address, sub_address, data):
+        if address != TUNER_SNAPSHOT_I2C_ADDRESS or sub_address != 0:
+            return
+        if data[0] == TUNER_SNAPSHOT_CMD_DRAIN:
+            with self.lock:
+                burst = self.ring[:TUNER_SNAPSHOT_BURST_SIZE]
+                del self.ring[:TUNER_SNAPSHOT_BURST_SIZE]
+                header = SNAPSHOT_HEADER.pack(0, len(burst), len(self.ring), self.dropped)
+            self.slave.publish(TUNER_SNAPSHOT_I2C_ADDRESS, 0, header + b"".join(burst))
+        else:
+            # Acknowledge the command.
+            self.slave.publish(TUNER_SNAPSHOT_I2C_ADDRESS, 0, b"\x00")
+
+    def run(self):
+        start = time.monotonic()
+        while True:
+            for i in range(self.num_sensors):
+                if random.random() < 0.3:
+                    self.values[i] = max(0, min(0xFFFF, self.values[i] + random.randint(-8, 8)))
+            padding = [0] * (TUNER_SNAPSHOT_MAX_SENSORS - self.num_sensors)
+            with self.lock:
+                self.sequence = (self.sequence + 1) & 0xFFFF
+                if len(self.ring) >= TUNER_SNAPSHOT_RING_SIZE:
+                    self.dropped += 1
+                else:
+                    self.ring.append(SNAPSHOT.pack(
+                        int((time.monotonic() - start) * 1000) & 0xFFFFFFFF, self.sequence, 0, 0,
+                        self.num_sensors, *(self.values + padding),
+                        *([1000] * self.num_sensors + padding),
+                        *([max(0, raw - 1000) for raw in self.values] + padding)))
+            time.sleep(self.period)
+
+
+def serve(args):
+    if args.demo and not os.path.isfile(args.encoder_lib):
+        sys.exit("%s not found; build it with make -C host_sim lib" % args.encoder_lib)
+    if os.path.exists(args.socket):
+        os.unlink(args.socket)
+    slave = Ezi2cSlave(realtime=args.realtime)
+    server = Server(args.socket, RequestHandler)
+    server.slave = slave
+    device = None
+    if args.demo:
+        device = DemoDevice(slave, args.map_size, args.sensors, args.scan_hz or 100.0,
+                            args.encoder_lib)
+    elif args.demo_snapshot:
+        device = SnapshotDemoDevice(slave, args.sensors, args.scan_hz or FAST_SCAN_HZ)
+    if device is not None:
+        threading.Thread(target=device.run, daemon=True).start()
+    print("EZI2C loopback on %s%s" % (args.socket, " (demo device)" if device else ""),
+          file=sys.stderr)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+        os.unlink(args.socket)
+        print("%u transactions, %.3f s of modeled bus time"
+              % (slave.transactions, slave.bus_seconds), file=sys.stderr)
+
+
+def bench(args):
+    """Polls the tuner like a host bridge would. Every poll is followed by a
+    wait for its bus time at 400 kHz, so the frames delivered and missed are
+    those of a real bus, while the latency is that of the socket."""
+    client = Client(args.socket)
+    latencies = []
+    sequences = set()
+    values = {}
+    dropped_range = []
+    start_time = time.monotonic()
+    deadline = start_time + args.duration
+
+    while time.monotonic() < deadline:
+        start = time.monotonic()
+        start_bus_seconds = client.bus_seconds
+        if args.mode == "full":
+            # The base stays at 0, so the map is read without a sub-address.
+            data = client.read_base(TUNER_I2C_ADDRESS, args.map_size)
+            sequences.add(struct.unpack_from("<H", data)[0])
+        else:
+            # The command write leaves the base at 0, at the header.
+            client.write(TUNER_STREAM_I2C_ADDRESS, 0, bytes([TUNER_STREAM_CMD_NEXT]))
+            header = client.read_base(TUNER_STREAM_I2C_ADDRESS, WINDOW_HEADER.size)
+            command, num_frames, length, dropped = WINDOW_HEADER.unpack(header)
+            dropped_range = [dropped_range[0] if dropped_range else dropped, dropped]
+            if command == 0 and length:
+                data = client.read(TUNER_STREAM_I2C_ADDRESS, WINDOW_HEADER.size, length)
+                for sequence, _ in decode_stream(data, values):
+                    sequences.add(sequence)
+        latencies.append(time.monotonic() - start)
+        poll_seconds = client.bus_seconds - start_bus_seconds
+        remaining = poll_seconds + args.poll_interval - (time.monotonic() - start)
+        if remaining > 0:
+            time.sleep(remaining)
+
+    elapsed = time.monotonic() - start_time
+    if args.mode == "stream":
+        # The first window may hold the backlog of an earlier run, so count
+        # the frames the device dropped during this run only.
+        missed = dropped_range[1] - dropped_range[0] if dropped_range else 0
+    elif sequences:
+        # Sequences are 16-bit; a run shorter than 65536 frames does not wrap.
+        missed = max(sequences) - min(sequences) + 1 - len(sequences)
+    else:
+        missed = 0
+
+    latencies.sort()
+    print("mode:                 %s" % args.mode)
+    print("polls:                %u" % len(latencies))
+    print("frames received:      %u (%.0f frames/s)" % (len(sequences), len(sequences) / elapsed))
+    print("frames missed:        %u" % missed)
+    print("bus bytes:            %u (%.1f per frame)"
+          % (client.bus_bytes, client.bus_bytes / max(1, len(sequences))))
+    print("bus utilization:      %.0f %% at %u kHz"
+          % (100.0 * client.bus_seconds / elapsed, BUS_RATE_HZ // 1000))
+    if latencies:
+        print("socket latency:       p50 %.0f us, p99 %.0f us"
+              % (latencies[len(latencies) // 2] * 1e6,
+                 latencies[min(len(latencies) - 1, (len(latencies) * 99) // 100)] * 1e6))
+
+
+def drain_session(client):
+    """Runs one drain session of source/tuner_snapshot.h. Returns the
+    snapshots as tuples of the SNAPSHOT fields, the snapshots in the ring at
+    the start of the session, the dropped count of the device, and the bus
+    bytes."""
+    snapshots = []
+    backlog = None
+    start_bus_bytes = client.bus_bytes
+    dropped = 0
+
+    while True:
+        # The first transfer may be NACKed while the device wakes up.
+        for attempt in range(10):
+            try:
+                client.write(TUNER_SNAPSHOT_I2C_ADDRESS, 0, bytes([TUNER_SNAPSHOT_CMD_DRAIN]))
+                break
+            except IOError:
+                if attempt == 9:
+                    raise
+                time.sleep(0.001)
+
+        # The command write leaves the base at 0, at the header.
+        for _ in range(100):
+            header = client.read_base(TUNER_SNAPSHOT_I2C_ADDRESS, SNAPSHOT_HEADER.size)
+            command, count, pending, dropped = SNAPSHOT_HEADER.unpack(header)
+            if command == 0:
+                break
+        else:
+            raise IOError("drain command not executed")
+        if backlog is None:
+            backlog = count + pending
+
+        if count:
+            data = client.read(TUNER_SNAPSHOT_I2C_ADDRESS, SNAPSHOT_HEADER.size,
+                               count * SNAPSHOT.size)
+            snapshots += [SNAPSHOT.unpack_from(data, i * SNAPSHOT.size) for i in range(count)]
+        if not pending:
+            break
+
+    client.write(TUNER_SNAPSHOT_I2C_ADDRESS, 0, bytes([TUNER_SNAPSHOT_CMD_RELEASE]))
+    return snapshots, backlog, dropped, client.bus_bytes - start_bus_bytes
+
+
+def drain(args):
+    """Drains the snapshot ring once per interval, like a host that logs the
+    production scan flow."""
+    client = Client(args.socket)
+    sessions = 0
+    received = 0
+    missed = 0
+    largest = 0
+    bus_bytes = 0
+    dropped_range = []
+    last_sequence = None
+    deadline = time.monotonic() + args.duration
+
+    while True:
+        start = time.monotonic()
+        snapshots, backlog, dropped, session_bytes = drain_session(client)
+        sessions += 1
+        received += len(snapshots)
+        largest = max(largest, backlog)
+        bus_bytes += session_bytes
+        dropped_range = [dropped_range[0] if dropped_range else dropped, dropped]
+
+        for snapshot in snapshots:
+            timestamp, sequence, widget, status, num_sensors = snapshot[:5]
+            if last_sequence is not None:
+                missed += (sequence - last_sequence - 1) & 0xFFFF
+            last_sequence = sequence
+            if args.verbose:
+                raw = snapshot[5:5 + num_sensors]
+                baseline = snapshot[5 + TUNER_SNAPSHOT_MAX_SENSORS:][:num_sensors]
+                diff = snapshot[5 + 2 * TUNER_SNAPSHOT_MAX_SENSORS:][:num_sensors]
+                print("%10u ms  seq %5u  widget %u  status 0x%02X  raw %s  baseline %s  diff %s"
+                      % (timestamp, sequence, widget, status, list(raw), list(baseline),
+                         list(diff)))
+
+        if time.monotonic() >= deadline:
+            break
+        remaining = args.interval - (time.monotonic() - start)
+        if remaining > 0:
+            time.sleep(remaining)
+
+    print("sessions:             %u every %.3f s" % (sessions, args.interval))
+    print("snapshots received:   %u" % received)
+    print("snapshots missed:     %u (%u dropped by the device during the run)"
+          % (missed, dropped_range[1] - dropped_range[0]))
+    print("largest backlog:      %u of %u ring entries" % (largest, TUNER_SNAPSHOT_RING_SIZE))
+    print("bus bytes:            %u (%.1f per snapshot)" % (bus_bytes, bus_bytes / max(1, received)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--socket", default=DEFAULT_SOCKET, help="Unix socket path")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    serve_parser = commands.add_parser("serve", help="run the emulated slave")
+    demo_group = serve_parser.add_mutually_exclusive_group()
+    demo_group.add_argument("--demo", action="store_true",
+                            help="attach the built-in firmware emulation")
+    demo_group.add_argument("--demo-snapshot", action="store_true",
+                            help="attach the emulation of the TUNER_SNAPSHOT_ENABLE firmware")
+    serve_parser.add_argument("--realtime", action="store_true",
+                              help="delay every transaction by its 400 kHz bus time")
+    serve_parser.add_argument("--encoder-lib", default=DEFAULT_ENCODER_LIB,
+                              help="stream encoder library for --demo")
+    serve_parser.add_argument("--map-size", type=int, default=256)
+    serve_parser.add_argument("--sensors", type=int, default=6)
+    serve_parser.add_argument("--scan-hz", type=float, default=None,
+                              help="scan rate of the demo device (default 100, or %g "
+                                   "with --demo-snapshot)" % FAST_SCAN_HZ)
+
+    bench_parser = commands.add_parser("bench", help="measure tuner throughput")
+    bench_parser.add_argument("--mode", choices=["full", "stream"], default="full")
+    bench_parser.add_argument("--duration", type=float, default=5.0)
+    bench_parser.add_argument("--map-size", type=int, default=256)
+    bench_parser.add_argument("--poll-interval", type=float, default=0.0,
+                              help="idle time in seconds between the polls")
+
+    drain_parser = commands.add_parser("drain", help="drain the tuner snapshot ring")
+    drain_parser.add_argument("--interval", type=float,
+                              default=TUNER_SNAPSHOT_HOST_POLL_INTERVAL_MS / 1000.0,
+                              help="time in seconds from the start of one session to the next")
+    drain_parser.add_argument("--duration", type=float, default=0.0,
+                              help="run for this many seconds; 0 runs one session")
+    drain_parser.add_argument("-v", "--verbose", action="store_true",
+                              help="print every snapshot")
+
+    read_parser = commands.add_parser("read", help="read from a slave")
+    read_parser.add_argument("address", type=lambda x: int(x, 0))
+    read_parser.add_argument("sub_address", type=lambda x: int(x, 0))
+    read_parser.add_argument("length", type=int)
+
+    write_parser = commands.add_parser("write", help="write to a slave")
+    write_parser.add_argument("address", type=lambda x: int(x, 0))
+    write_parser.add_argument("sub_address", type=lambda x: int(x, 0))
+    write_parser.add_argument("data", nargs="*", type=lambda x: int(x, 0))
+
+    args = parser.parse_args()
+
+    if args.command == "serve":
+        serve(args)
+    elif args.command == "bench":
+        bench(args)
+    elif args.command == "drain":
+        drain(args)
+    elif args.command == "read":
+        print(Client(args.socket).read(args.address, args.sub_address, args.length).hex(" "))
+    elif args.command == "write":
+        Client(args.socket).write(args.address, args.sub_address, bytes(args.data))
+
+
+if __name__ == "__main__":
+    main()
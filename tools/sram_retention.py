@@ -0,0 +1,311 @@
+#!/usr/bin/env python3
+"""SRAM retention planner for the low-power CAPSENSE example.
+
+Reads the linker map (and optionally the linker script) of the CM4 image,
+reports which SRAM0 power macros hold the vectors, data, bss, heap and stack,
+and prints the retention table: the mask of the macros that can be powered off
+in deep sleep. If the SRAM0_POWER_DOWN_MASK configured in low_power_config.c
+covers a macro that holds live data, the script exits with a non-zero status so
+that the build fails.
+
+Without --map, only the ram region of the linker script is known; it is live
+as a whole, so the plan is that of any image linked with the script:
+
+    sram_retention.py --linker-script <linker script>.ld
+
+The Makefile runs it as a pre-build step to generate the default
+SRAM0_POWER_DOWN_MASK of low_power_config.c, the recommended mask of the linker
+script, into a header:
+
+    sram_retention.py --linker-script <linker script>.ld \\
+                      --header build/<TARGET>/<CONFIG>/generated/sram_retention_mask.h
+
+and as a post-build step with the GCC_ARM toolchain, to check the mask that is
+in effect (the first --config that defines it) against the linked image:
+
+    sram_retention.py --map build/<TARGET>/<CONFIG>/<APPNAME>.map \\
+                      --linker-script <linker script>.ld \\
+                      --config source/TARGET_<TARGET>/low_power_config.c \\
+                      --config build/<TARGET>/<CONFIG>/generated/sram_retention_mask.h
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SRAM_BASE = 0x08000000
+MACRO_SIZE = 0x8000
+
+# SRAM0 layout per device family, keyed by the linker script name prefix.
+# reserved: macros that hold the CM0+ RAM or the system call area and must
+# never be powered off, independent of the CM4 image.
+DEVICES = {
+    "cy8c6xx7": {"macros": 9, "reserved": [0, 8]},
+    "cy8c6xxa": {"macros": 16, "reserved": [0]},
+    "cyb06xxa": {"macros": 16, "reserved": [0]},
+    "cy8c6xx5": {"macros": 8, "reserved": [0, 7]},
+    "cy8c6xx4": {"macros": 4, "reserved": [0, 3]},
+}
+
+# CM4 RAM regions defined by the linker symbols, in address order.
+REGIONS = [
+    ("vectors", "__ram_vectors_start__", "__ram_vectors_end__"),
+    ("data", "__data_start__", "__data_end__"),
+    ("bss", "__bss_start__", "__bss_end__"),
+    ("heap", "__HeapBase", "__HeapLimit"),
+    ("stack", "__StackLimit", "__StackTop"),
+]
+
+SYMBOL_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+(?:PROVIDE \()?(__\w+)")
+MEMORY_RE = re.compile(r"^(\w+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+LD_MEMORY_RE = re.compile(
+    r"^\s*(\w+)\s*\([^)]*\)\s*:\s*ORIGIN\s*=\s*(0x[0-9a-fA-F]+)\s*,"
+    r"\s*LENGTH\s*=\s*(0x[0-9a-fA-F]+)")
+MASK_RE = re.compile(r"#define\s+SRAM0_POWER_DOWN_MASK\s+\(?\s*(0x[0-9a-fA-F]+|\d+)")
+
+
+def parse_map(path):
+    """Returns the memory regions and the linker symbols of a GCC map file."""
+    memory = {}
+    symbols = {}
+    in_memory = False
+
+    with open(path, "r", errors="replace") as map_file:
+        for line in map_file:
+            if line.startswith("Memory Configuration"):
+                in_memory = True
+                continue
+            if line.startswith("Linker script and memory map"):
+                in_memory = False
+                continue
+
+            if in_memory:
+                match = MEMORY_RE.match(line)
+                if match and match.group(1) != "default":
+                    memory[match.group(1)] = (int(match.group(2), 16),
+                                              int(match.group(3), 16))
+                continue
+
+            match = SYMBOL_RE.match(line)
+            if match:
+                symbols[match.group(2)] = int(match.group(1), 16)
+
+    return memory, symbols
+
+
+def parse_linker_script(path):
+    """Returns the memory regions of the MEMORY command of a linker script."""
+    memory = {}
+
+    with open(path, "r") as ld_file:
+        for line in ld_file:
+            match = LD_MEMORY_RE.match(line)
+            if match:
+                memory[match.group(1)] = (int(match.group(2), 16),
+                                          int(match.group(3), 16))
+
+    return memory
+
+
+def parse_mask(paths):
+    """Returns SRAM0_POWER_DOWN_MASK and the file that defines it, from the
+    first of the files that defines it, or (None, None)."""
+    for path in paths:
+        with open(path, "r") as config_file:
+            match = MASK_RE.search(config_file.read())
+        if match:
+            return int(match.group(1), 0), path
+
+    return None, None
+
+
+def write_header(path, mask, linker_script):
+    """Writes the header with the default SRAM0_POWER_DOWN_MASK. The file is
+    left untouched if it is up to date, so that nothing is rebuilt."""
+    if mask is None:
+        comment = ("The SRAM0 layout is unknown (no linker script of a known "
+                   "device),\n * so every macro is retained.")
+        mask = 0
+    else:
+        comment = ("Recommended mask of %s:\n * the SRAM0 macros that hold "
+                   "neither the CM4 RAM nor a reserved area."
+                   % os.path.basename(linker_script))
+
+    text = ("/* Generated by tools/sram_retention.py. Do not edit. */\n"
+            "#ifndef SRAM_RETENTION_MASK_H\n"
+            "#define SRAM_RETENTION_MASK_H\n"
+            "\n"
+            "/* SRAM0 macros powered off in deep sleep, bit n for macro n, unless\n"
+            " * low_power_config.c defines SRAM0_POWER_DOWN_MASK before including\n"
+            " * this file. %s\n"
+            " */\n"
+            "#ifndef SRAM0_POWER_DOWN_MASK\n"
+            "#define SRAM0_POWER_DOWN_MASK                (0x%04XUL)\n"
+            "#endif\n"
+            "\n"
+            "#endif /* SRAM_RETENTION_MASK_H */\n" % (comment, mask))
+
+    if os.path.isfile(path):
+        with open(path, "r") as header_file:
+            if header_file.read() == text:
+                return
+    if os.path.dirname(path):
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "w") as header_file:
+        header_file.write(text)
+
+
+def find_device(linker_script):
+    name = os.path.basename(linker_script or "").lower()
+    for prefix, device in DEVICES.items():
+        if name.startswith(prefix):
+            return prefix, device
+    return None, None
+
+
+def macro_range(start, end):
+    """Returns the SRAM0 macro indexes that overlap [start, end)."""
+    if end <= start:
+        return range(0)
+    first = (max(start, SRAM_BASE) - SRAM_BASE) // MACRO_SIZE
+    last = (end - 1 - SRAM_BASE) // MACRO_SIZE
+    return range(first, last + 1) if end > SRAM_BASE else range(0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--map", help="linker map file (default: plan from the "
+                                      "linker script only)")
+    parser.add_argument("--linker-script", help="GCC linker script (.ld)")
+    parser.add_argument("--config", action="append",
+                        help="low_power_config.c or generated header to "
+                             "check; the first that defines the mask is used")
+    parser.add_argument("--header",
+                        help="write the recommended mask of the linker script "
+                             "to this header as the default mask and exit")
+    parser.add_argument("--macros", type=int,
+                        help="number of SRAM0 macros (default: from the "
+                             "linker script name)")
+    args = parser.parse_args()
+
+    memory, symbols = parse_map(args.map) if args.map else ({}, {})
+    if args.linker_script and os.path.isfile(args.linker_script):
+        memory.update(parse_linker_script(args.linker_script))
+
+    family, device = find_device(args.linker_script)
+    num_macros = args.macros or (device["macros"] if device else 16)
+    reserved = device["reserved"] if device else [0]
+
+    if "ram" not in memory:
+        print("sram_retention: %s: no 'ram' region in %s"
+              % ("warning" if args.header else "error",
+                 args.map or args.linker_script or "no linker script"),
+              file=sys.stderr)
+        if args.header:
+            write_header(args.header, None, None)
+            return 0
+        return 1
+
+    ram_origin, ram_length = memory["ram"]
+    print("SRAM retention plan (%s, %d SRAM0 macros of %d KB)"
+          % (family or "unknown device", num_macros, MACRO_SIZE // 1024))
+    print("  ram region:  0x%08X - 0x%08X (%d bytes)"
+          % (ram_origin, ram_origin + ram_length, ram_length))
+
+    # Contents of every macro.
+    contents = {i: [] for i in range(num_macros)}
+    for i in reserved:
+        contents[i].append("reserved")
+
+    live_mask = 0
+    highest = ram_origin
+    for name, start_symbol, end_symbol in REGIONS:
+        if start_symbol not in symbols or end_symbol not in symbols:
+            continue
+        start = symbols[start_symbol]
+        end = symbols[end_symbol]
+        print("  %-8s     0x%08X - 0x%08X (%d bytes)"
+              % (name + ":", start, end, end - start))
+        if end > start:
+            highest = max(highest, end)
+            for i in macro_range(start, end):
+                if i < num_macros:
+                    contents[i].append(name)
+                    live_mask |= 1 << i
+
+    if "__bss_end__" in symbols:
+        print("  static RAM ends at 0x%08X, highest live address 0x%08X"
+              % (symbols["__bss_end__"], highest - 1))
+
+    # The ram region is live as a whole even if the symbols are missing.
+    ram_macros = [i for i in macro_range(ram_origin, ram_origin + ram_length)
+                  if i < num_macros]
+    for i in ram_macros + reserved:
+        if i < num_macros:
+            live_mask |= 1 << i
+    for i in ram_macros:
+        if all(name == "reserved" for name in contents[i]):
+            contents[i].append("ram")
+
+    all_mask = (1 << num_macros) - 1
+    recommended = all_mask & ~live_mask
+    configured, config = parse_mask(args.config or [])
+
+    if args.header:
+        # The map does not exist yet at pre-build, so the generated mask is
+        # that of the linker script.
+        write_header(args.header, recommended, args.linker_script)
+        print("sram_retention: SRAM0_POWER_DOWN_MASK 0x%04X written to %s"
+              % (recommended, args.header))
+        return 0
+
+    print()
+    print("  macro  address range            contents              deep sleep")
+    for i in range(num_macros):
+        start = SRAM_BASE + i * MACRO_SIZE
+        if configured is None:
+            action = "retain" if live_mask & (1 << i) else "power off"
+        else:
+            action = "power off" if configured & (1 << i) else "retain"
+        print("  %5d  0x%08X - 0x%08X  %-20s  %s"
+              % (i, start, start + MACRO_SIZE,
+                 ", ".join(contents[i]) or "unused", action))
+
+    # Macros retained only because they hold the CM4 RAM. Packing the RAM
+    # tighter, or moving data out of it after initialization, can release
+    # only these.
+    cm4_only = [str(i) for i in ram_macros if i not in reserved]
+    print()
+    if not ram_macros:
+        print("  the ram region is outside of SRAM0")
+    print("  macros retained for the CM4 RAM only: %s" % (", ".join(cm4_only) or "none"))
+    print("  recommended SRAM0_POWER_DOWN_MASK: 0x%04X" % recommended)
+
+    if configured is None:
+        return 0
+
+    print("  configured  SRAM0_POWER_DOWN_MASK: 0x%04X (%s)"
+          % (configured, config))
+
+    conflict = configured & live_mask
+    if conflict:
+        macros = [str(i) for i in range(num_macros) if conflict & (1 << i)]
+        print("sram_retention: error: SRAM0_POWER_DOWN_MASK powers off "
+              "macro(s) %s that hold live data" % ", ".join(macros),
+              file=sys.stderr)
+        return 1
+
+    if configured & ~all_mask:
+        print("sram_retention: warning: SRAM0_POWER_DOWN_MASK has bits above "
+              "macro %d" % (num_macros - 1), file=sys.stderr)
+
+    if recommended & ~configured:
+        print("  note: 0x%04X more can be powered off"
+              % (recommended & ~configured))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
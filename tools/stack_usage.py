@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""Worst-case stack usage of the tasks and interrupt handlers of the CM4 image.
+
+Combines the frame size of every function from the .su files written by GCC
+with -fstack-usage and the call graph from the disassembly of the ELF file,
+and reports the deepest call path of every root function. Task roots are
+checked against their stack size, including the exception frames that the
+FreeRTOS ARM_CM4F port stores on the task stack; the build fails if a stack is
+too small. The stack sizes are given in words (StackType_t), as passed to
+xTaskCreate, either as numbers or as the names of macros read from the
+--header files, so the check follows the sizes that the image is built with.
+
+The Makefile runs it with the GCC_ARM toolchain as the stack_usage target:
+
+    make stack_usage TARGET=<kit>
+
+    stack_usage.py --build-dir build/<TARGET>/<CONFIG> \\
+                   --elf build/<TARGET>/<CONFIG>/<APPNAME>.elf \\
+                   --header source/capsense.h --header source/touch_event.h \\
+                   --header FreeRTOSConfig.h \\
+                   --task capsense_task=CAPSENSE_TASK_STACK_SIZE_WORDS \\
+                   --task touch_event_task=TOUCH_EVENT_TASK_STACK_SIZE_WORDS \\
+                   --callback scan_timer_callback=prvTimerTask:configTIMER_TASK_STACK_DEPTH \\
+                   --isr capsense_isr --isr scan_lptimer_callback
+
+Indirect calls (through function pointers) cannot be followed and are listed
+per root; the analysis is an upper bound only if the functions reached through
+them are given as roots too. Recursion is reported and counted once.
+"""
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+# Stored on the task stack when the task is interrupted and switched out by
+# the ARM_CM4F port: the extended exception frame with the FPU registers
+# (26 words), and r4-r11, r14 and s16-s31 saved by xPortPendSVHandler
+# (25 words).
+TASK_SWITCH_FRAME_SIZE = 26 * 4 + 25 * 4
+
+# Extended exception frame stored on the main stack by each nested interrupt.
+EXCEPTION_FRAME_SIZE = 26 * 4
+
+# sizeof(StackType_t) of the ARM_CM4F port.
+STACK_WORD_SIZE = 4
+
+SU_RE = re.compile(r"^(.*):(\d+):(\d+):([^\t]+)\t(\d+)\t(\S+)")
+FUNCTION_RE = re.compile(r"^([0-9a-f]+) <([^>]+)>:$")
+TARGET_RE = re.compile(r"^[0-9a-f]+ <([^>+]+)>$")
+DEFINE_RE = re.compile(r"^\s*#\s*define\s+(\w+)\s+(.+?)\s*(?:/[/*].*)?$")
+IDENTIFIER_RE = re.compile(r"\b[A-Za-z_]\w*\b")
+INTEGER_RE = re.compile(r"\b(0[xX][0-9a-fA-F]+|\d+)[uUlL]*\b")
+BRANCH_MNEMONICS = ("b", "b.n", "b.w")
+CALL_MNEMONICS = ("bl", "blx")
+
+
+def parse_stack_usage(build_dir):
+    """Returns {function: (bytes, qualifier)} from the .su files. Static
+    functions with the same name in different files keep the larger frame."""
+    frames = {}
+
+    for root, _, files in os.walk(build_dir):
+        for name in files:
+            if not name.endswith(".su"):
+                continue
+            with open(os.path.join(root, name), "r", errors="replace") as su_file:
+                for line in su_file:
+                    match = SU_RE.match(line)
+                    if not match:
+                        continue
+                    function = match.group(4)
+                    size = int(match.group(5))
+                    if function not in frames or frames[function][0] < size:
+                        frames[function] = (size, match.group(6))
+
+    return frames
+
+
+def parse_call_graph(objdump, elf):
+    """Returns {function: set of callees} and {function: number of indirect
+    calls} from the disassembly of the ELF file. A branch to the start of
+    another function is a tail call and is treated as a call."""
+    output = subprocess.run([objdump, "-d", "--no-show-raw-insn", elf], check=True,
+                            stdout=subprocess.PIPE, universal_newlines=True).stdout
+    calls = {}
+    indirect = {}
+    function = None
+
+    for line in output.splitlines():
+        match = FUNCTION_RE.match(line)
+        if match:
+            function = match.group(2)
+            calls.setdefault(function, set())
+            indirect.setdefault(function, 0)
+            continue
+        if function is None:
+            continue
+
+        fields = line.split("\t")
+        if len(fields) < 3:
+            continue
+        mnemonic = fields[1].strip()
+        operand = fields[2].strip()
+        target = TARGET_RE.match(operand)
+        if mnemonic in CALL_MNEMONICS + BRANCH_MNEMONICS and target:
+            if target.group(1) != function:
+                calls[function].add(target.group(1))
+        elif (mnemonic == "blx") or (mnemonic == "bx" and operand != "lr"):
+            indirect[function] += 1
+
+    return calls, indirect
+
+
+def worst_path(function, frames, calls, memo, active, recursive):
+    """Returns (bytes, path) of the deepest call path from function. Functions
+    that call themselves through the path are added to recursive."""
+    if function in memo:
+        return memo[function]
+    if function in active:
+        recursive.add(function)
+        return 0, []
+
+    size = frames.get(function, (0, "static"))[0]
+
+    active.add(function)
+    deepest = (0, [])
+    for callee in sorted(calls.get(function, ())):
+        result = worst_path(callee, frames, calls, memo, active, recursive)
+        if result[0] > deepest[0]:
+            deepest = result
+    active.discard(function)
+
+    result = (size + deepest[0], [function] + deepest[1])
+    memo[function] = result
+    return result
+
+
+def reachable(function, calls):
+    seen = set()
+    pending = [function]
+    while pending:
+        current = pending.pop()
+        if current not in seen:
+            seen.add(current)
+            pending.extend(calls.get(current, ()))
+    return seen
+
+
+def parse_defines(headers):
+    """Returns {macro: replacement} of the object-like macros of the headers.
+    The first definition of a macro is kept, whatever its #if guard."""
+    defines = {}
+
+    for header in headers:
+        with open(header, "r", errors="replace") as header_file:
+            for line in header_file:
+                match = DEFINE_RE.match(line)
+                if match and match.group(1) not in defines:
+                    defines[match.group(1)] = match.group(2)
+
+    return defines
+
+
+def evaluate_size(value, defines, depth=0):
+    """Returns the value of a number, or of an integer expression of numbers
+    and the macros of defines."""
+    if depth > 16:
+        raise ValueError("macro nesting too deep in %s" % value)
+    expression = INTEGER_RE.sub(lambda match: "(%d)" % int(match.group(1), 0), value)
+    expression = IDENTIFIER_RE.sub(
+        lambda match: "(%d)" % evaluate_size(defines[match.group(0)], defines, depth + 1)
+        if match.group(0) in defines else match.group(0), expression)
+    if not re.fullmatch(r"[0-9\s()+*/-]+", expression):
+        raise ValueError("cannot evaluate the stack size %s" % value)
+    return int(eval(expression.replace("/", "//"), {"__builtins__": {}}))
+
+
+def parse_size_arg(value, defines):
+    """Returns (function, bytes) of FUNCTION=WORDS."""
+    name, size = value.split("=")
+    return name, evaluate_size(size, defines) * STACK_WORD_SIZE
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--build-dir", required=True,
+                        help="directory searched for the .su files")
+    parser.add_argument("--elf", required=True, help="linked image")
+    parser.add_argument("--objdump", default="arm-none-eabi-objdump",
+                        help="objdump of the toolchain")
+    parser.add_argument("--header", action="append", default=[], metavar="FILE",
+                        help="header whose macros can be given as stack sizes")
+    parser.add_argument("--task", action="append", default=[], metavar="FUNCTION=WORDS",
+                        help="task function and its stack size in words")
+    parser.add_argument("--callback", action="append", default=[],
+                        metavar="FUNCTION=TASK:WORDS",
+                        help="callback called indirectly from a task function, "
+                             "checked against the stack of that task")
+    parser.add_argument("--isr", action="append", default=[], metavar="FUNCTION",
+                        help="interrupt handler, runs on the main stack")
+    parser.add_argument("-v", "--verbose", action="store_true",
+                        help="print the deepest call path of every root")
+    args = parser.parse_args()
+
+    objdump = args.objdump
+    if not os.path.isfile(objdump) and shutil.which(objdump) is None:
+        objdump = "arm-none-eabi-objdump"
+
+    frames = parse_stack_usage(args.build_dir)
+    if not frames:
+        print("stack_usage: no .su files in %s; build with -fstack-usage" % args.build_dir,
+              file=sys.stderr)
+        return 1
+    calls, indirect = parse_call_graph(objdump, args.elf)
+
+    defines = parse_defines(args.header)
+    roots = []
+    try:
+        for value in args.task:
+            name, size = parse_size_arg(value, defines)
+            roots.append(("task", name, None, size))
+        for value in args.callback:
+            name, rest = value.split("=")
+            task, size = rest.split(":")
+            roots.append(("callback", name, task, evaluate_size(size, defines) * STACK_WORD_SIZE))
+    except ValueError as error:
+        print("stack_usage: %s" % error, file=sys.stderr)
+        return 1
+    for name in args.isr:
+        roots.append(("isr", name, None, None))
+
+    memo = {}
+    recursive = set()
+    failed = False
+    print("Worst-case stack usage (bytes)")
+    print("  root                        kind      path  frames  limit  free")
+
+    for kind, name, task, limit in roots:
+        if name not in calls and name not in frames:
+            print("  %-26s  %-8s  not found in the image" % (name, kind))
+            continue
+
+        depth, path = worst_path(name, frames, calls, memo, set(), recursive)
+        extra = 0
+        if kind == "task":
+            extra = TASK_SWITCH_FRAME_SIZE
+        elif kind == "callback":
+            # The dispatching task calls the callback from somewhere within its
+            # own call tree; its worst case bounds the frames below the call.
+            extra = TASK_SWITCH_FRAME_SIZE + worst_path(task, frames, calls, memo, set(),
+                                                        recursive)[0]
+        else:
+            extra = EXCEPTION_FRAME_SIZE
+
+        total = depth + extra
+        if limit is None:
+            print("  %-26s  %-8s  %4d  %6d      -     -" % (name, kind, depth, extra))
+        else:
+            free = limit - total
+            print("  %-26s  %-8s  %4d  %6d  %5d  %4d%s"
+                  % (name, kind, depth, extra, limit, free, "  OVERFLOW" if free < 0 else ""))
+            failed = failed or free < 0
+
+        if args.verbose:
+            print("      path: %s" % " -> ".join(
+                "%s(%d)" % (function, frames.get(function, (0,))[0]) for function in path))
+        functions = reachable(name, calls)
+        num_indirect = sum(indirect.get(function, 0) for function in functions)
+        if num_indirect:
+            print("      %d indirect call(s) not followed" % num_indirect)
+        notes = (
+            ("recursion", sorted(functions & recursive)),
+            ("dynamic frames", sorted("%s (%s)" % (function, frames[function][1])
+                                      for function in functions
+                                      if function in frames and frames[function][1] != "static")),
+            ("no .su entry, counted as 0", sorted(function for function in functions
+                                                  if function not in frames)))
+        for label, names in notes:
+            if names:
+                print("      %s: %s" % (label, ", ".join(names)))
+
+    print()
+    print("  frames: exception and context-switch frames stored on the stack of the root")
+    print("  interrupt handlers run on the main stack; add their totals for the")
+    print("  interrupt priorities that can nest")
+
+    if failed:
+        print("stack_usage: error: a task stack is smaller than its worst case", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
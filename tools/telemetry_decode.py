@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+"""Decoder for the binary telemetry of the low-power CAPSENSE example.
+
+The firmware sends the frames when it is built with TELEMETRY_ENABLE. See
+source/telemetry.h for the frame layout.
+
+The frames carry the time since the previous frame. The decoder anchors the
+time on the sync frames that carry the absolute time, and prints "?" as the
+time of the frames after a decoding error until the next sync frame.
+
+Usage:
+    telemetry_decode.py /dev/ttyACM0          # serial port (requires pyserial)
+    telemetry_decode.py capture.bin           # captured stream
+    telemetry_decode.py - < capture.bin       # standard input
+    telemetry_decode.py --raw capture.bin     # fields instead of text
+"""
+
+import argparse
+import sys
+
+SYNC_BYTE = 0xA5
+SYNC_TYPE = 0x7F
+MAX_PAYLOAD_SIZE = 15
+
+# touch_event_type_t in source/touch_event.h
+SLIDER_POSITION = 0
+SCAN_RATE = 1
+GESTURE = 2
+AVERAGE_CURRENT = 3
+TRIGGER_LATENCY = 4
+TOUCH_STATE = 5
+SENSOR_COUNTS = 6
+DROPPED = 7
+STACK_HIGH_WATER = 8
+RUN_TIME = 9
+
+# touch_event_stack_task_t in source/touch_event.h and runtime_stats_task_t in
+# source/runtime_stats.h
+TASK_NAMES = ["CapSense Task", "Touch Event Task", "Timer Task", "Idle Task"]
+
+# scan_policy_transition_t in source/scan_policy.h
+SCAN_POLICY_WAKE_UP = 2
+SCAN_POLICY_PRE_WARM = 3
+
+# gesture_type_t in source/gesture.h
+GESTURE_NAMES = ["none", "tap", "double tap", "long press", "swipe", "flick"]
+
+# Widget IDs in the CAPSENSE configuration
+LINEARSLIDER0_WDGT_ID = 0
+WIDGET_NAMES = ["LinearSlider0", "GangedSensor"]
+
+
+def crc8(data):
+    """CRC-8, polynomial 0x07, initial value 0."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def parse_payload(payload):
+    """Returns the [dt_ms, value, arg, data] fields of a payload."""
+    fields = []
+    value = 0
+    shift = 0
+    for byte in payload:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            fields.append(value)
+            value = 0
+            shift = 0
+    if shift != 0 or len(fields) > 4:
+        raise ValueError("malformed payload")
+    fields += [0] * (4 - len(fields))
+    fields[3] = (fields[3] >> 1) ^ -(fields[3] & 1)
+    return fields
+
+
+def format_event(event_type, value, arg, data):
+    """Formats an event the same way as the firmware built without telemetry."""
+    if event_type == SLIDER_POSITION:
+        return "Slider position = %u" % value
+    if event_type == SCAN_RATE:
+        if arg == SCAN_POLICY_WAKE_UP:
+            return "Touch detected, switching to fast scan."
+        if arg == SCAN_POLICY_PRE_WARM:
+            return "Touch expected, switching to %u ms scan." % value
+        if data == LINEARSLIDER0_WDGT_ID:
+            return "Fast scan time-out, switching to %u ms scan." % value
+        return "Slow scan time-out, switching to %u ms scan." % value
+    if event_type == GESTURE:
+        name = GESTURE_NAMES[arg] if arg < len(GESTURE_NAMES) else "unknown"
+        return "Gesture: %s at %u, velocity = %d" % (name, value, data)
+    if event_type == AVERAGE_CURRENT:
+        return "Modeled average current = %u.%03u uA" % (data // 1000, data % 1000)
+    if event_type == TRIGGER_LATENCY:
+        return "Max scan trigger latency = %u us" % data
+    if event_type == TOUCH_STATE:
+        widget = WIDGET_NAMES[arg] if arg < len(WIDGET_NAMES) else str(arg)
+        return "%s %s" % (widget, "touched" if value else "released")
+    if event_type == SENSOR_COUNTS:
+        widget = arg >> 4
+        widget = WIDGET_NAMES[widget] if widget < len(WIDGET_NAMES) else str(widget)
+        return "%s sensor %u: raw = %u, diff = %d" % (widget, arg & 0x0F, value, data)
+    if event_type == DROPPED:
+        return "Touch events dropped = %u" % data
+    if event_type == STACK_HIGH_WATER:
+        task = TASK_NAMES[arg] if arg < len(TASK_NAMES) else str(arg)
+        return "%s stack high water mark: %u bytes free" % (task, data)
+    if event_type == RUN_TIME:
+        task = TASK_NAMES[arg] if arg < len(TASK_NAMES) else str(arg)
+        return "%s run time = %u us (%u.%u %%)" % (task, data, value // 10, value % 10)
+    return "Unknown event %u: value = %u, arg = %u, data = %d" % (event_type, value, arg, data)
+
+
+class Decoder:
+    """Incremental frame decoder. Resynchronizes on the sync byte after a
+    CRC error, and re-anchors the time on the next sync frame."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.timestamp_ms = None
+        self.frames = 0
+        self.syncs = 0
+        self.errors = 0
+
+    def feed(self, data):
+        """Adds received bytes and yields (timestamp_ms, event_type, value, arg,
+        data) per event frame. timestamp_ms is None until the time is anchored
+        on a sync frame."""
+        self.buffer += data
+        while True:
+            start = self.buffer.find(SYNC_BYTE)
+            if start < 0:
+                self.buffer.clear()
+                return
+            del self.buffer[:start]
+            if len(self.buffer) < 3:
+                return
+            length = self.buffer[2]
+            if length > MAX_PAYLOAD_SIZE:
+                self.errors += 1
+                self.timestamp_ms = None
+                del self.buffer[:1]
+                continue
+            if len(self.buffer) < length + 4:
+                return
+            frame = bytes(self.buffer[:length + 4])
+            try:
+                if crc8(frame[1:-1]) != frame[-1]:
+                    raise ValueError("CRC error")
+                dt_ms, value, arg, data = parse_payload(frame[3:-1])
+            except ValueError:
+                self.errors += 1
+                self.timestamp_ms = None
+                del self.buffer[:1]
+                continue
+            del self.buffer[:length + 4]
+            if frame[1] == SYNC_TYPE:
+                self.syncs += 1
+                self.timestamp_ms = dt_ms
+                continue
+            self.frames += 1
+            if self.timestamp_ms is not None:
+                self.timestamp_ms = (self.timestamp_ms + dt_ms) & 0xFFFFFFFF
+            yield self.timestamp_ms, frame[1], value, arg, data
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin.buffer
+    try:
+        import serial
+        return serial.Serial(path, baudrate, timeout=0.1)
+    except ImportError:
+        return open(path, "rb")
+    except (OSError, ValueError):
+        return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="serial port, capture file, or - for stdin")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200)
+    parser.add_argument("--raw", action="store_true",
+                        help="print the fields of the frames instead of text")
+    args = parser.parse_args()
+
+    decoder = Decoder()
+    stream = open_input(args.input, args.baudrate)
+    is_serial = hasattr(stream, "in_waiting")
+
+    try:
+        while True:
+            data = stream.read(256)
+            if not data:
+                if is_serial:
+                    continue
+                break
+            for timestamp_ms, event_type, value, arg, event_data in decoder.feed(data):
+                if args.raw:
+                    print("%s %u %u %u %d" % ("?" if timestamp_ms is None else timestamp_ms,
+                                              event_type, value, arg, event_data), flush=True)
+                elif timestamp_ms is None:
+                    print("%10s  %s" % ("?", format_event(event_type, value, arg, event_data)),
+                          flush=True)
+                else:
+                    print("%10.3f  %s" % (timestamp_ms / 1000.0,
+                                          format_event(event_type, value, arg, event_data)),
+                          flush=True)
+    except KeyboardInterrupt:
+        pass
+
+    print("%u frames, %u syncs, %u errors" % (decoder.frames, decoder.syncs, decoder.errors),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()